@@ -0,0 +1,209 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <future>
+#include <vector>
+
+#include "renderer.h"
+
+namespace complate {
+
+/**
+ * Renderer which renders on worker threads owned by it.
+ *
+ * Upon construction a fixed number of worker threads is started, each with
+ * its own Renderer created by the Creator. `renderAsync()` queues a render
+ * and returns immediately, so threads which must not block, like the I/O
+ * threads of an event loop, can hand off the JavaScript execution.
+ *
+ * Renders are distributed round robin over a queue per worker. A worker
+ * whose queue is empty steals the oldest render of another worker, so a slow
+ * render doesn't hold up the renders queued behind it while others are idle.
+ *
+ * The blocking `render()` methods are supported too, they queue the render
+ * and wait for it.
+ */
+class AsyncRenderer : public Renderer {
+public:
+  /** Options to size the executor. */
+  struct Options {
+    /** Number of worker threads and Renderer's, zero uses the cores. */
+    std::size_t threads = 0;
+  };
+
+  /** Counters of a worker thread. */
+  struct WorkerStats {
+    /** Number of renders waiting in the queue of the worker. */
+    std::size_t queued = 0;
+    /** Total number of renders executed by the worker. */
+    std::uint64_t executed = 0;
+    /** Total number of renders the worker stole from other queues. */
+    std::uint64_t stolen = 0;
+    /** Total time the worker has been rendering. */
+    std::chrono::nanoseconds busy = std::chrono::nanoseconds::zero();
+    /** Fraction of the time since construction spent rendering. */
+    double utilization = 0;
+  };
+
+  /** Counters of all worker threads. */
+  struct Stats {
+    /** Number of renders waiting in all queues. */
+    std::size_t queued = 0;
+    /** Total number of renders executed. */
+    std::uint64_t executed = 0;
+    /** Total number of renders stolen from other queues. */
+    std::uint64_t stolen = 0;
+    /** Counters of each worker thread. */
+    std::vector<WorkerStats> workers;
+  };
+
+  /** Called on a worker thread when a render has finished, must not throw. */
+  using Completion = std::function<void(std::exception_ptr)>;
+
+  /**
+   * Constructs an AsyncRenderer
+   *
+   * Upon construction the Renderer's are created on the calling thread, so
+   * exceptions of the Creator are thrown here.
+   *
+   * @param creator This function will be used to create a Renderer for every
+   * worker thread.
+   * @param options Options to size the executor.
+   */
+  AsyncRenderer(const Creator &creator, Options options);
+
+  /**
+   * Constructs an AsyncRenderer with default Options.
+   *
+   * @param creator This function will be used to create a Renderer for every
+   * worker thread.
+   */
+  explicit AsyncRenderer(const Creator &creator);
+
+  /** Finishes all queued renders and stops the worker threads. */
+  ~AsyncRenderer() override;
+
+  /**
+   * Queue rendering a view to a string using an Object as parameters.
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view.
+   * @return A future for the HTML output, it holds the exception when
+   * rendering has failed.
+   */
+  [[nodiscard]] std::future<std::string> renderAsync(std::string view,
+                                                     Object parameters);
+
+  /**
+   * Queue rendering a view to a string using a JSON string as parameters.
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view. It has to be an JSON Object.
+   * @return A future for the HTML output, it holds the exception when
+   * rendering has failed.
+   */
+  [[nodiscard]] std::future<std::string> renderAsync(std::string view,
+                                                     std::string parameters);
+
+  /**
+   * Queue rendering a view to a Stream using an Object as parameters.
+   *
+   * The output is written to the Stream on a worker thread while being
+   * rendered, afterwards the completion is called on the same thread.
+   *
+   * @attention The Stream has to stay valid until the completion is called.
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view.
+   * @param stream A stream in which the HTML output will be forwarded.
+   * @param completion Called with the exception when rendering has failed,
+   * with nullptr otherwise.
+   */
+  void renderAsync(std::string view, Object parameters, Stream &stream,
+                   Completion completion);
+
+  /**
+   * Queue rendering a view to a Stream using a JSON string as parameters.
+   *
+   * @see renderAsync(std::string, Object, Stream &, Completion)
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view. It has to be an JSON Object.
+   * @param stream A stream in which the HTML output will be forwarded.
+   * @param completion Called with the exception when rendering has failed,
+   * with nullptr otherwise.
+   */
+  void renderAsync(std::string view, std::string parameters, Stream &stream,
+                   Completion completion);
+
+  /**
+   * Render a view on a worker thread and wait for it, using an Object as
+   * parameters.
+   *
+   * @note This method allows to achieve "progressive rendering".
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view.
+   * @param stream A stream in which the HTML output will be forwarded.
+   */
+  void render(const std::string &view, const Object &parameters,
+              Stream &stream) override;
+
+  /**
+   * Render a view on a worker thread and wait for it, using a JSON string as
+   * parameters.
+   *
+   * @note This method allows to achieve "progressive rendering".
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view. It has to be an JSON Object.
+   * @param stream A stream in which the HTML output will be forwarded.
+   */
+  void render(const std::string &view, const std::string &parameters,
+              Stream &stream) override;
+
+  /**
+   * Same as above, but forwards the JSON as string_view without copying it.
+   */
+  void render(const std::string &view, std::string_view parameters,
+              Stream &stream) override;
+  using Renderer::render;
+
+  /** Number of worker threads */
+  [[nodiscard]] std::size_t threads() const;
+
+  /** Get the current counters. */
+  [[nodiscard]] Stats stats() const;
+
+private:
+  class Impl;
+
+  /** Pointer to implementation */
+  std::unique_ptr<Impl> m_impl;
+};
+}  // namespace complate
@@ -0,0 +1,101 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+
+#include "stream.h"
+
+namespace complate {
+
+/**
+ * Stream which coalesces writes before forwarding them to another Stream.
+ *
+ * Views emit many tiny writes and flush after every closing tag. This
+ * decorator collects them in a buffer and forwards them as a few large
+ * writes. A `flush()` initiated by the view is only forwarded, when enough
+ * output has been buffered or the last forwarded flush is long enough ago.
+ *
+ * Call `drain()` after rendering, to forward the remaining buffered output.
+ * It's also done upon destruction. It stores the reference to the given
+ * Stream.
+ */
+class BufferedStream : public Stream {
+public:
+  /** Options for buffering and the flush policy. */
+  struct Options {
+    /** Capacity of the buffer, it's written to the Stream when exceeded. */
+    std::size_t bufferSize = 16384;
+    /** Forward `flush()` when at least this number of bytes are buffered. */
+    std::size_t flushThreshold = 4096;
+    /** Forward `flush()` when the last one is longer ago, zero disables. */
+    std::chrono::milliseconds flushInterval = std::chrono::milliseconds::zero();
+  };
+
+  /**
+   * Construct a BufferedStream.
+   *
+   * @param dest The underlying stream in which the content will be forwarded
+   * (reference stored).
+   * @param options Options for buffering and the flush policy.
+   */
+  BufferedStream(Stream &dest, Options options);
+
+  /**
+   * Construct a BufferedStream with default Options.
+   *
+   * @param dest The underlying stream in which the content will be forwarded
+   * (reference stored).
+   */
+  explicit BufferedStream(Stream &dest);
+
+  /** Forwards the remaining buffered output, errors are ignored. */
+  ~BufferedStream() override;
+
+  /**
+   * Append a string to the buffer.
+   *
+   * @param str String not necessarily null terminated.
+   * @param len Length of the string to write.
+   */
+  void write(const char *str, int len) override;
+
+  /**
+   * Append a string followed by a newline to the buffer.
+   *
+   * @param str String not necessarily null terminated.
+   * @param len Length of the string to write.
+   */
+  void writeln(const char *str, int len) override;
+
+  /**
+   * Forward the buffer and flush the underlying stream, according to the
+   * flush policy. Otherwise the call is ignored.
+   */
+  void flush() override;
+
+  /** Forward the buffer and flush the underlying stream unconditionally. */
+  void drain();
+
+private:
+  class Impl;
+
+  /** Pointer to implementation */
+  std::unique_ptr<Impl> m_impl;
+};
+}  // namespace complate
@@ -0,0 +1,140 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "renderer.h"
+
+namespace complate {
+
+/**
+ * Renderer which caches the output of another Renderer.
+ *
+ * The output is cached by view name and parameters, so rendering the same view
+ * with equal parameters again writes the cached output to the Stream in one
+ * call, without running the view. Use it when views are pure functions of
+ * their parameters, e.g. for pages served to anonymous users.
+ *
+ * The cache is split into shards, each bounded in size and evicting the least
+ * recently used output. Parameters holding a Function, Proxy or ProxyWeak are
+ * never cached, because their output may change without them.
+ *
+ * @note Concurrent misses of the same output render it more than once.
+ */
+class CachingRenderer : public Renderer {
+public:
+  /** Options to size the cache. */
+  struct Options {
+    /** Maximum bytes of cached output and keys over all shards. */
+    std::size_t maxBytes = 64 * 1024 * 1024;
+    /** Number of independently locked shards. */
+    std::size_t shards = 16;
+    /** Time the output is served from the cache, zero caches forever. */
+    std::chrono::milliseconds ttl = std::chrono::milliseconds::zero();
+  };
+
+  /** Counters of the cache. */
+  struct Stats {
+    /** Number of cached outputs. */
+    std::size_t entries = 0;
+    /** Bytes of cached outputs and keys. */
+    std::size_t bytes = 0;
+    /** Total number of renders served from the cache. */
+    std::uint64_t hits = 0;
+    /** Total number of renders forwarded to the Renderer. */
+    std::uint64_t misses = 0;
+    /** Total number of outputs evicted to stay within the size. */
+    std::uint64_t evicted = 0;
+    /** Total number of outputs dropped because their ttl has passed. */
+    std::uint64_t expired = 0;
+  };
+
+  /**
+   * Constructs a CachingRenderer
+   *
+   * Upon construction a Renderer will be created, it has to support being
+   * called from every thread calling `render()`.
+   *
+   * @param creator This function will be used to create the Renderer.
+   * @param options Options to size the cache.
+   */
+  CachingRenderer(const Creator &creator, Options options);
+
+  /**
+   * Constructs a CachingRenderer with default Options.
+   *
+   * @param creator This function will be used to create the Renderer.
+   */
+  explicit CachingRenderer(const Creator &creator);
+
+  ~CachingRenderer() override;
+
+  /**
+   * Render a view to a Stream using an Object as parameters, using cached
+   * output if available.
+   *
+   * On a miss the output is forwarded to the Stream while being rendered and
+   * cached after the view has succeeded.
+   *
+   * @note This method allows to achieve "progressive rendering".
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view.
+   * @param stream A stream in which the HTML output will be forwarded.
+   */
+  void render(const std::string &view, const Object &parameters,
+              Stream &stream) override;
+
+  /**
+   * Render a view to a Stream using a JSON string as parameters, using cached
+   * output if available.
+   *
+   * The JSON is compared as text, so it's best produced deterministically.
+   *
+   * @note This method allows to achieve "progressive rendering".
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view. It has to be an JSON Object.
+   * @param stream A stream in which the HTML output will be forwarded.
+   */
+  void render(const std::string &view, const std::string &parameters,
+              Stream &stream) override;
+
+  /**
+   * Same as above, but forwards the JSON as string_view without copying it.
+   */
+  void render(const std::string &view, std::string_view parameters,
+              Stream &stream) override;
+  using Renderer::render;
+
+  /** Get the current counters. */
+  [[nodiscard]] Stats stats() const;
+
+  /** Drop all cached output, e.g. after the views have changed. */
+  void clear();
+
+private:
+  class Impl;
+
+  /** Pointer to implementation */
+  std::unique_ptr<Impl> m_impl;
+};
+}  // namespace complate
@@ -0,0 +1,362 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace complate {
+
+/**
+ * Map which keeps its entries sorted by key in a single vector.
+ *
+ * It offers the part of the std::map interface used for Object. A lookup is
+ * a binary search over contiguous memory and the entries live in a single
+ * allocation instead of a node each. Entries added in ascending key order
+ * are appended without moving others.
+ *
+ * @note Unlike std::map, adding or erasing entries invalidates iterators,
+ * pointers and references to other entries. Like std::flat_map, iterators
+ * dereference to a pair of references instead of a value_type.
+ *
+ * @example
+ * @code
+ * FlatMap<std::string, int> ages{{"John", 42}, {"Jane", 23}};
+ * ages.emplace("Klaus", 17);
+ * int age = ages.at("Jane");
+ */
+template <typename Key, typename T, typename Compare = std::less<>>
+class FlatMap {
+  /** Entries are stored with a mutable key, which isn't exposed */
+  using Entry = std::pair<Key, T>;
+  using Entries = std::vector<Entry>;
+
+  template <bool Const>
+  class Iterator;
+
+public:
+  using key_type = Key;
+  using mapped_type = T;
+  using value_type = std::pair<const Key, T>;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+  using key_compare = Compare;
+  /** Like std::flat_map, it refers to the key and value of an entry. */
+  using reference = std::pair<const Key &, T &>;
+  using const_reference = std::pair<const Key &, const T &>;
+  using iterator = Iterator<false>;
+  using const_iterator = Iterator<true>;
+
+  FlatMap() = default;
+
+  /** Like std::map, the first entry of duplicate keys wins. */
+  FlatMap(std::initializer_list<value_type> init) : FlatMap() {
+    m_entries.reserve(init.size());
+    for (const auto &entry : init) {
+      emplace(entry);
+    }
+  }
+
+  template <typename InputIt>
+  FlatMap(InputIt first, InputIt last) : FlatMap() {
+    for (; first != last; ++first) {
+      emplace(*first);
+    }
+  }
+
+  iterator begin() noexcept { return iterator(m_entries.begin()); }
+  const_iterator begin() const noexcept { return cbegin(); }
+  const_iterator cbegin() const noexcept {
+    return const_iterator(m_entries.cbegin());
+  }
+  iterator end() noexcept { return iterator(m_entries.end()); }
+  const_iterator end() const noexcept { return cend(); }
+  const_iterator cend() const noexcept {
+    return const_iterator(m_entries.cend());
+  }
+
+  [[nodiscard]] bool empty() const noexcept { return m_entries.empty(); }
+  [[nodiscard]] size_type size() const noexcept { return m_entries.size(); }
+  void clear() noexcept { m_entries.clear(); }
+  /** Reserve room for entries, which std::map can't offer. */
+  void reserve(size_type capacity) { m_entries.reserve(capacity); }
+
+  template <typename K>
+  iterator lower_bound(const K &key) {
+    return iterator(entryLowerBound(key));
+  }
+
+  template <typename K>
+  const_iterator lower_bound(const K &key) const {
+    return const_iterator(std::lower_bound(
+        m_entries.begin(), m_entries.end(), key, KeyLess()));
+  }
+
+  template <typename K>
+  iterator find(const K &key) {
+    return iterator(entryFind(key));
+  }
+
+  template <typename K>
+  const_iterator find(const K &key) const {
+    auto it = lower_bound(key);
+    return (it != end() && !Compare()(key, it->first)) ? it : end();
+  }
+
+  template <typename K>
+  [[nodiscard]] size_type count(const K &key) const {
+    return (find(key) != end()) ? 1 : 0;
+  }
+
+  template <typename K>
+  T &at(const K &key) {
+    auto it = entryFind(key);
+    if (it == m_entries.end()) {
+      throw std::out_of_range("FlatMap::at");
+    }
+    return it->second;
+  }
+
+  template <typename K>
+  const T &at(const K &key) const {
+    auto it = find(key);
+    if (it == end()) {
+      throw std::out_of_range("FlatMap::at");
+    }
+    return it->second;
+  }
+
+  T &operator[](const Key &key) { return try_emplace(key).first->second; }
+
+  T &operator[](Key &&key) {
+    return try_emplace(std::move(key)).first->second;
+  }
+
+  template <typename... Args>
+  std::pair<iterator, bool> emplace(Args &&...args) {
+    Entry entry(std::forward<Args>(args)...);
+    auto it = position(entry.first);
+    if (it != m_entries.end() && !Compare()(entry.first, it->first)) {
+      return {iterator(it), false};
+    }
+    return {iterator(m_entries.insert(it, std::move(entry))), true};
+  }
+
+  template <typename K, typename... Args>
+  std::pair<iterator, bool> try_emplace(K &&key, Args &&...args) {
+    auto it = position(key);
+    if (it != m_entries.end() && !Compare()(key, it->first)) {
+      return {iterator(it), false};
+    }
+    it = m_entries.emplace(it, std::piecewise_construct,
+                           std::forward_as_tuple(std::forward<K>(key)),
+                           std::forward_as_tuple(std::forward<Args>(args)...));
+    return {iterator(it), true};
+  }
+
+  std::pair<iterator, bool> insert(const value_type &entry) {
+    return emplace(entry);
+  }
+
+  std::pair<iterator, bool> insert(value_type &&entry) {
+    return emplace(std::move(entry));
+  }
+
+  template <typename K, typename M>
+  std::pair<iterator, bool> insert_or_assign(K &&key, M &&obj) {
+    auto result = try_emplace(std::forward<K>(key), std::forward<M>(obj));
+    if (!result.second) {
+      result.first->second = std::forward<M>(obj);
+    }
+    return result;
+  }
+
+  iterator erase(iterator pos) {
+    return iterator(m_entries.erase(pos.m_it));
+  }
+
+  iterator erase(const_iterator pos) {
+    return iterator(m_entries.erase(pos.m_it));
+  }
+
+  size_type erase(const Key &key) { return eraseKey(key); }
+
+  /** Erase by a key of another type, if Compare is transparent. */
+  template <typename K, typename C = Compare,
+            typename = typename C::is_transparent>
+  size_type erase(const K &key) {
+    return eraseKey(key);
+  }
+
+  bool operator==(const FlatMap &other) const {
+    return m_entries == other.m_entries;
+  }
+
+  bool operator!=(const FlatMap &other) const { return !(*this == other); }
+
+private:
+  struct KeyLess {
+    template <typename K>
+    bool operator()(const Entry &entry, const K &key) const {
+      return Compare()(entry.first, key);
+    }
+  };
+
+  Entries m_entries;
+
+  template <typename K>
+  typename Entries::iterator entryLowerBound(const K &key) {
+    return std::lower_bound(m_entries.begin(), m_entries.end(), key,
+                            KeyLess());
+  }
+
+  template <typename K>
+  typename Entries::iterator entryFind(const K &key) {
+    auto it = entryLowerBound(key);
+    return (it != m_entries.end() && !Compare()(key, it->first))
+               ? it
+               : m_entries.end();
+  }
+
+  template <typename K>
+  size_type eraseKey(const K &key) {
+    auto it = entryFind(key);
+    if (it == m_entries.end()) {
+      return 0;
+    }
+    m_entries.erase(it);
+    return 1;
+  }
+
+  /** Where to insert key, appending without a search when possible */
+  template <typename K>
+  typename Entries::iterator position(const K &key) {
+    if (m_entries.empty() || Compare()(m_entries.back().first, key)) {
+      return m_entries.end();
+    }
+    return entryLowerBound(key);
+  }
+};
+
+/**
+ * Iterator which dereferences to a pair of references, so the key of an
+ * entry can't be assigned and break the order.
+ */
+template <typename Key, typename T, typename Compare>
+template <bool Const>
+class FlatMap<Key, T, Compare>::Iterator {
+  using Base = std::conditional_t<Const, typename Entries::const_iterator,
+                                  typename Entries::iterator>;
+
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = FlatMap::value_type;
+  using difference_type = std::ptrdiff_t;
+  using reference =
+      std::conditional_t<Const, FlatMap::const_reference, FlatMap::reference>;
+
+  /** Holds the reference, which is a temporary */
+  class pointer {
+  public:
+    const reference *operator->() const { return &m_reference; }
+
+  private:
+    friend class Iterator;
+    explicit pointer(reference ref) : m_reference(ref) {}
+    reference m_reference;
+  };
+
+  Iterator() = default;
+
+  /** An iterator converts to a const_iterator. */
+  template <bool Other, typename = std::enable_if_t<Const && !Other>>
+  Iterator(const Iterator<Other> &other) : m_it(other.m_it) {}
+
+  reference operator*() const { return reference(m_it->first, m_it->second); }
+  pointer operator->() const { return pointer(**this); }
+  reference operator[](difference_type n) const { return *(*this + n); }
+
+  Iterator &operator++() {
+    ++m_it;
+    return *this;
+  }
+
+  Iterator operator++(int) { return Iterator(m_it++); }
+
+  Iterator &operator--() {
+    --m_it;
+    return *this;
+  }
+
+  Iterator operator--(int) { return Iterator(m_it--); }
+
+  Iterator &operator+=(difference_type n) {
+    m_it += n;
+    return *this;
+  }
+
+  Iterator &operator-=(difference_type n) {
+    m_it -= n;
+    return *this;
+  }
+
+  friend Iterator operator+(Iterator it, difference_type n) { return it += n; }
+  friend Iterator operator+(difference_type n, Iterator it) { return it += n; }
+  friend Iterator operator-(Iterator it, difference_type n) { return it -= n; }
+
+  friend difference_type operator-(const Iterator &a, const Iterator &b) {
+    return a.m_it - b.m_it;
+  }
+
+  friend bool operator==(const Iterator &a, const Iterator &b) {
+    return a.m_it == b.m_it;
+  }
+
+  friend bool operator!=(const Iterator &a, const Iterator &b) {
+    return a.m_it != b.m_it;
+  }
+
+  friend bool operator<(const Iterator &a, const Iterator &b) {
+    return a.m_it < b.m_it;
+  }
+
+  friend bool operator>(const Iterator &a, const Iterator &b) {
+    return a.m_it > b.m_it;
+  }
+
+  friend bool operator<=(const Iterator &a, const Iterator &b) {
+    return a.m_it <= b.m_it;
+  }
+
+  friend bool operator>=(const Iterator &a, const Iterator &b) {
+    return a.m_it >= b.m_it;
+  }
+
+private:
+  friend class FlatMap;
+  friend class Iterator<!Const>;
+  explicit Iterator(Base it) : m_it(it) {}
+  Base m_it;
+};
+}  // namespace complate
@@ -0,0 +1,54 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+
+namespace complate {
+
+/**
+ * Native implementation of complate-stream's `htmlEncode(str, attribute)`.
+ *
+ * Escapes `&`, `<` and `>`, within attributes also `'` and `"`, using the
+ * same entities as complate-stream. The scan for these characters processes
+ * 16 bytes at once when SSE2 is available. The renderers use it for their
+ * native `htmlEncode`, which scans the strings within the engine.
+ */
+class HtmlEncode {
+public:
+  /**
+   * Find the first character which needs to be escaped.
+   *
+   * @param str String to scan.
+   * @param attribute Whether `'` and `"` need to be escaped too.
+   * @return Position of the character or std::string_view::npos.
+   */
+  [[nodiscard]] static std::size_t find(std::string_view str,
+                                        bool attribute = false);
+
+  /**
+   * Escape a string.
+   *
+   * @param str String to escape.
+   * @param attribute Whether `'` and `"` need to be escaped too.
+   * @return The escaped string.
+   */
+  [[nodiscard]] static std::string encode(std::string_view str,
+                                          bool attribute = false);
+};
+}  // namespace complate
@@ -0,0 +1,85 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <string>
+#include <string_view>
+
+#include "value.h"
+
+namespace complate {
+
+/**
+ * Conversion between JSON and Value.
+ *
+ * The parser follows `JSON.parse`: integers fitting into int32 become an
+ * int32 Number, all other numbers a double and of duplicate keys the last
+ * one wins. The scans for the end of strings process 16 bytes at once when
+ * SSE2 is available.
+ *
+ * @example
+ * @code
+ * Value model = Json::parse(R"({"name": "John", "age": 42})");
+ * std::string json = Json::stringify(model);
+ */
+class Json {
+public:
+  /**
+   * Parse JSON into a Value.
+   *
+   * @param json The JSON text, it's not referenced after the call.
+   * @return The parsed Value.
+   * @throw complate::Exception if the JSON is malformed.
+   */
+  [[nodiscard]] static Value parse(std::string_view json);
+
+  /**
+   * Parse JSON into a Value, referencing the strings within the JSON text.
+   *
+   * Strings without escape sequences are stored as string_view pointing into
+   * the JSON text. Only object keys and escaped strings are copied.
+   *
+   * @attention The JSON text has to outlive the returned Value.
+   *
+   * @param json The JSON text.
+   * @return The parsed Value.
+   * @throw complate::Exception if the JSON is malformed.
+   */
+  [[nodiscard]] static Value parseView(std::string_view json);
+
+  /**
+   * Serialize a Value into JSON.
+   *
+   * Like `JSON.stringify`, fields of an Object holding Undefined, a Function,
+   * a Proxy or a ProxyWeak are omitted, elsewhere they become `null`. So do
+   * numbers which are not finite.
+   *
+   * @param value The Value to serialize.
+   * @return The JSON text.
+   */
+  [[nodiscard]] static std::string stringify(const Value &value);
+
+  /**
+   * Serialize a Value into JSON, appending it to a string.
+   *
+   * @see stringify(const Value &)
+   *
+   * @param value The Value to serialize.
+   * @param out String the JSON text is appended to.
+   */
+  static void stringify(const Value &value, std::string &out);
+};
+}  // namespace complate
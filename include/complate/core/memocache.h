@@ -0,0 +1,118 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace complate {
+
+/**
+ * Cache for the HTML of view fragments, used by the `memo` binding.
+ *
+ * Renderers configured with a MemoCache install a global
+ * `memo(key, component)`, which views use to mark fragments depending on
+ * nothing but the key, like a footer or a navigation. The first render of a
+ * key stores the HTML, all following renders write it to the Stream without
+ * running the component.
+ *
+ * `component` is a function returning the element, so the JSX isn't even
+ * evaluated on a hit. The cache is thread safe and can be shared by all
+ * renderers, e.g. of a RendererPool.
+ *
+ * @example
+ * @code
+ * // JSX, the key has to include everything the HTML depends on
+ * <Layout>
+ *   {memo(`footer-${lang}`, () => <Footer lang={lang} />)}
+ * </Layout>
+ */
+class MemoCache {
+public:
+  /**
+   * Construct a MemoCache.
+   *
+   * @param maxBytes Maximum bytes of keys and HTML. The least recently used
+   * HTML is dropped to stay below it, a fragment exceeding it on it's own is
+   * rendered without being stored.
+   */
+  explicit MemoCache(std::size_t maxBytes = 16 * 1024 * 1024);
+
+  /**
+   * Get the HTML stored for a key, which becomes the most recently used.
+   *
+   * @param key Key passed to `memo`.
+   * @return The HTML or nullptr.
+   */
+  [[nodiscard]] std::shared_ptr<const std::string> get(
+      std::string_view key) const;
+
+  /**
+   * Store the HTML for a key, replacing a previous one.
+   *
+   * @param key Key passed to `memo`.
+   * @param html The rendered HTML.
+   * @return Whether the HTML has been stored, it isn't when key and HTML
+   * exceed maxBytes on their own.
+   */
+  bool put(std::string_view key, std::string html);
+
+  /**
+   * Drop the HTML of a key, so it's rendered again.
+   *
+   * @param key Key passed to `memo`.
+   */
+  void invalidate(std::string_view key);
+
+  /** Drop the HTML of all keys. */
+  void clear();
+
+  /** Number of stored keys */
+  [[nodiscard]] std::size_t size() const;
+
+  /** Bytes of stored keys and HTML */
+  [[nodiscard]] std::size_t bytes() const;
+
+  /**
+   * JavaScript source of the `memo` binding, used by renderers.
+   *
+   * The source evaluates to a function, which has to be called with a native
+   * object providing `replay(stream, key)` and `store(key, html)`. It returns
+   * the `memo` function.
+   */
+  [[nodiscard]] static std::string_view script();
+
+private:
+  struct Entry {
+    std::string m_key;
+    std::shared_ptr<const std::string> m_html;
+  };
+
+  std::size_t m_maxBytes;
+  std::size_t m_bytes = 0;
+  mutable std::mutex m_mutex;
+  /** Most recently used at the front, keys point into the entries */
+  mutable std::list<Entry> m_entries;
+  std::unordered_map<std::string_view, std::list<Entry>::iterator> m_lookup;
+
+  void erase(std::list<Entry>::iterator entry);
+};
+}  // namespace complate
@@ -19,6 +19,7 @@
 #include <memory>
 #include <string>
 
+#include "nativecall.h"
 #include "value.h"
 
 namespace complate {
@@ -36,9 +37,15 @@ public:
   /** Callback signature. */
   using Callback = std::function<Value(void *, const Array &args)>;
 
+  /** Typed callback signature, see NativeCall. */
+  using Invoker = NativeCall::Invoker;
+
   /** Constructs a Method with a callback. */
   Method(std::string name, Callback callback);
 
+  /** Constructs a typed Method, which is called without Value's. */
+  Method(std::string name, Invoker invoker);
+
   Method(const Method &other);
 
   ~Method();
@@ -54,24 +61,27 @@ public:
       : Method(std::move(name), wrap(callback)) {}
 
   /**
-   * Construct with a member function accepting no arguments.
+   * Construct with a member function accepting typed arguments.
+   *
+   * The arguments are converted directly into the parameter types and the
+   * result directly into a JavaScript value, see NativeCall.
    *
    * @param name Name of your method.
    * @param callback Member function pointer, for example &YourClass::getText.
    */
-  template <typename T, typename R>
-  Method(std::string name, R (T::*callback)())
-      : Method(std::move(name), wrap(callback)) {}
+  template <typename T, typename R, typename... A>
+  Method(std::string name, R (T::*callback)(A...))
+      : Method(std::move(name), NativeCall::bind(callback)) {}
 
   /**
-   * Construct with a const member function accepting no arguments.
+   * Construct with a const member function accepting typed arguments.
    *
    * @param name Name of your method.
    * @param callback Member function pointer, for example &YourClass::getText.
    */
-  template <typename T, typename R>
-  Method(std::string name, R (T::*callback)() const)
-      : Method(std::move(name), wrap(callback)) {}
+  template <typename T, typename R, typename... A>
+  Method(std::string name, R (T::*callback)(A...) const)
+      : Method(std::move(name), NativeCall::bind(callback)) {}
 
   /** Get the name of the Method */
   [[nodiscard]] const std::string &name() const;
@@ -89,6 +99,19 @@ public:
    */
   Value apply(void *object, const Array &args) const;
 
+  /** Check if this Method was constructed with an Invoker. */
+  [[nodiscard]] bool typed() const;
+
+  /**
+   * Call the Method with the arguments of a NativeCall.
+   *
+   * Returns undefined, if nullptr passed as object.
+   *
+   * @param object The pointer to the class instance (this).
+   * @param call Arguments and result of the call.
+   */
+  void invoke(void *object, NativeCall &call) const;
+
 private:
   class Impl;
 
@@ -110,37 +133,5 @@ private:
       };
     }
   }
-
-  /** Wraps a member function pointer with no args to an function with accept
-   * void* */
-  template <typename T, typename R>
-  static Callback wrap(R (T::*callback)()) {
-    if constexpr (std::is_void_v<R>) {
-      return [callback](void *p, const Array &) -> Value {
-        (static_cast<T *>(p)->*callback)();
-        return {};
-      };
-    } else {
-      return [callback](void *p, const Array &) -> Value {
-        return (static_cast<T *>(p)->*callback)();
-      };
-    }
-  }
-
-  /** Wraps a const member function pointer with no args to an function with
-   * accept void* */
-  template <typename T, typename R>
-  static Callback wrap(R (T::*callback)() const) {
-    if constexpr (std::is_void_v<R>) {
-      return [callback](void *p, const Array &) -> Value {
-        (static_cast<T *>(p)->*callback)();
-        return {};
-      };
-    } else {
-      return [callback](void *p, const Array &) -> Value {
-        return (static_cast<T *>(p)->*callback)();
-      };
-    }
-  }
 };
 }  // namespace complate
@@ -0,0 +1,258 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#include "value.h"
+
+namespace complate {
+
+/**
+ * Arguments and result of a call from JavaScript into native code.
+ *
+ * A Renderer implements this on top of its engine values, so typed Method's
+ * and Property's convert the JavaScript arguments directly into C++ types
+ * and their results directly into JavaScript values, without building a
+ * Value for each of them.
+ *
+ * Missing arguments are treated as undefined, the conversions follow the
+ * rules of the engine (e.g. undefined converts to 0 for integers). If a
+ * conversion throws, failed() turns true and the call is not made.
+ *
+ * @note Use bind() to create an Invoker from a member function.
+ */
+class NativeCall {
+public:
+  /** Signature of a typed call, object is the class instance (this). */
+  using Invoker = std::function<void(void *object, NativeCall &call)>;
+
+  virtual ~NativeCall() = default;
+
+  /** Number of arguments passed by JavaScript. */
+  [[nodiscard]] virtual int argc() const = 0;
+  /** True if a conversion threw, the exception is pending in the engine. */
+  [[nodiscard]] virtual bool failed() const = 0;
+
+  /** Convert the argument at index to bool. */
+  [[nodiscard]] virtual bool toBool(int index) = 0;
+  /** Convert the argument at index to int32_t. */
+  [[nodiscard]] virtual int32_t toInt32(int index) = 0;
+  /** Convert the argument at index to int64_t. */
+  [[nodiscard]] virtual int64_t toInt64(int index) = 0;
+  /** Convert the argument at index to double. */
+  [[nodiscard]] virtual double toDouble(int index) = 0;
+  /** Convert the argument at index to string. */
+  [[nodiscard]] virtual std::string toString(int index) = 0;
+  /** Convert the argument at index to a Value. */
+  [[nodiscard]] virtual Value toValue(int index) = 0;
+
+  /** Return undefined, which is the default. */
+  virtual void returnUndefined() = 0;
+  /** Return null. */
+  virtual void returnNull() = 0;
+  /** Return a bool. */
+  virtual void returnBool(bool value) = 0;
+  /** Return an int32_t. */
+  virtual void returnInt32(int32_t value) = 0;
+  /** Return an uint32_t. */
+  virtual void returnUint32(uint32_t value) = 0;
+  /** Return an int64_t. */
+  virtual void returnInt64(int64_t value) = 0;
+  /** Return a double. */
+  virtual void returnDouble(double value) = 0;
+  /** Return a string, which is copied. */
+  virtual void returnString(std::string_view value) = 0;
+  /** Return a Value. */
+  virtual void returnValue(const Value &value) = 0;
+
+  /**
+   * Create an Invoker for a member function.
+   *
+   * Each argument is converted via argument(), the result via result().
+   *
+   * @param member Member function pointer, for example &YourClass::getText.
+   */
+  template <typename T, typename R, typename... A>
+  static Invoker bind(R (T::*member)(A...)) {
+    return [member](void *object, NativeCall &call) {
+      call.invoke<R, A...>([member, object](auto &&...args) -> R {
+        return (static_cast<T *>(object)->*member)(
+            std::forward<decltype(args)>(args)...);
+      });
+    };
+  }
+
+  /** Create an Invoker for a const member function. */
+  template <typename T, typename R, typename... A>
+  static Invoker bind(R (T::*member)(A...) const) {
+    return [member](void *object, NativeCall &call) {
+      call.invoke<R, A...>([member, object](auto &&...args) -> R {
+        return (static_cast<const T *>(object)->*member)(
+            std::forward<decltype(args)>(args)...);
+      });
+    };
+  }
+
+  /** Create an Invoker for a function taking the object as reference. */
+  template <typename T, typename R, typename... A>
+  static Invoker bind(std::function<R(T &, A...)> callback) {
+    return [callback](void *object, NativeCall &call) {
+      call.invoke<R, A...>([&callback, object](auto &&...args) -> R {
+        return callback(*static_cast<T *>(object),
+                        std::forward<decltype(args)>(args)...);
+      });
+    };
+  }
+
+  /**
+   * Convert the argument at index to type A.
+   *
+   * Supported are bool, integers, floating points, std::string, Value and
+   * every other type a Value can be converted into via Value::get().
+   * A std::string_view argument is held as std::string while calling.
+   */
+  template <typename A>
+  auto argument(int index) {
+    using D = std::decay_t<A>;
+    if constexpr (std::is_same_v<D, bool>) {
+      return toBool(index);
+    } else if constexpr (std::is_integral_v<D> && sizeof(D) < 4) {
+      return static_cast<D>(toInt32(index));
+    } else if constexpr (std::is_integral_v<D> && sizeof(D) == 4 &&
+                         std::is_signed_v<D>) {
+      return static_cast<D>(toInt32(index));
+    } else if constexpr (std::is_integral_v<D>) {
+      return static_cast<D>(toInt64(index));
+    } else if constexpr (std::is_floating_point_v<D>) {
+      return static_cast<D>(toDouble(index));
+    } else if constexpr (std::is_same_v<D, std::string> ||
+                         std::is_same_v<D, std::string_view>) {
+      return toString(index);
+    } else if constexpr (std::is_same_v<D, Value>) {
+      return toValue(index);
+    } else {
+      return toValue(index).template get<D>();
+    }
+  }
+
+  /**
+   * Return a C++ value.
+   *
+   * Integers and floating points are returned as numbers, std::string,
+   * std::string_view and const char * as strings, and every other type is
+   * converted into a Value. 64 bit integers become what the engine maps a
+   * Number holding an int64_t to, a BigInt in V8.
+   */
+  template <typename R>
+  void result(R &&value) {
+    using D = std::decay_t<R>;
+    if constexpr (std::is_same_v<D, bool>) {
+      returnBool(value);
+    } else if constexpr (std::is_integral_v<D> && sizeof(D) <= 4 &&
+                         std::is_signed_v<D>) {
+      returnInt32(value);
+    } else if constexpr (std::is_integral_v<D> && sizeof(D) <= 4) {
+      returnUint32(value);
+    } else if constexpr (std::is_integral_v<D>) {
+      returnInt64(static_cast<int64_t>(value));
+    } else if constexpr (std::is_floating_point_v<D>) {
+      returnDouble(value);
+    } else if constexpr (std::is_same_v<D, std::string> ||
+                         std::is_same_v<D, std::string_view>) {
+      returnString(value);
+    } else if constexpr (std::is_same_v<D, const char *> ||
+                         std::is_same_v<D, char *>) {
+      if (value) {
+        returnString(value);
+      } else {
+        returnNull();
+      }
+    } else if constexpr (std::is_same_v<D, Value>) {
+      returnValue(value);
+    } else {
+      returnValue(Value(std::forward<R>(value)));
+    }
+  }
+
+private:
+  /** Convert the arguments, call the function and return its result. */
+  template <typename R, typename... A, typename F>
+  void invoke(F &&function) {
+    invoke<R, A...>(std::forward<F>(function), std::index_sequence_for<A...>());
+  }
+
+  template <typename R, typename... A, typename F, size_t... I>
+  void invoke(F &&function, std::index_sequence<I...>) {
+    // braced initialization converts the arguments from left to right
+    std::tuple<decltype(argument<A>(0))...> args{argument<A>((int)I)...};
+    if (failed()) {
+      return;
+    }
+    if constexpr (std::is_void_v<R>) {
+      function(std::get<I>(std::move(args))...);
+      returnUndefined();
+    } else {
+      result<R>(function(std::get<I>(std::move(args))...));
+    }
+  }
+};
+
+/**
+ * NativeCall on top of Value's.
+ *
+ * Used to call a typed Method or Property with an Array of arguments,
+ * for example by Method::apply().
+ */
+class ValueCall : public NativeCall {
+public:
+  /** Construct with the arguments, which must outlive the ValueCall. */
+  explicit ValueCall(const Array &args);
+  explicit ValueCall(Array &&) = delete;
+
+  /** The Value returned by the call. */
+  [[nodiscard]] const Value &value() const;
+
+  [[nodiscard]] int argc() const override;
+  [[nodiscard]] bool failed() const override;
+  [[nodiscard]] bool toBool(int index) override;
+  [[nodiscard]] int32_t toInt32(int index) override;
+  [[nodiscard]] int64_t toInt64(int index) override;
+  [[nodiscard]] double toDouble(int index) override;
+  [[nodiscard]] std::string toString(int index) override;
+  [[nodiscard]] Value toValue(int index) override;
+
+  void returnUndefined() override;
+  void returnNull() override;
+  void returnBool(bool value) override;
+  void returnInt32(int32_t value) override;
+  void returnUint32(uint32_t value) override;
+  void returnInt64(int64_t value) override;
+  void returnDouble(double value) override;
+  void returnString(std::string_view value) override;
+  void returnValue(const Value &value) override;
+
+private:
+  const Array &m_args;
+  Value m_value;
+};
+}  // namespace complate
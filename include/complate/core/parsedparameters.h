@@ -0,0 +1,64 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+
+namespace complate {
+
+/**
+ * Handle to JSON view parameters parsed by a renderer.
+ *
+ * The parsed parameters stay alive inside the renderer which created the
+ * handle as long as the handle or one of its copies exists. So the same
+ * parameters can be rendered with several views in a row, without being
+ * parsed again. The handle may outlive the renderer, but it can only be
+ * rendered by the renderer which created it.
+ *
+ * @example
+ * @code
+ * ParsedParameters parameters = renderer.parse(json);
+ * renderer.render("Page", parameters, stream);
+ * renderer.render("Teaser", parameters, stream);
+ */
+class ParsedParameters {
+public:
+  /** Construct an empty handle */
+  ParsedParameters() = default;
+
+  /**
+   * Construct a handle, used by renderers.
+   *
+   * @param owner The renderer specific owner of the parsed parameters.
+   * @param parsed The renderer specific representation of the parsed
+   * parameters, it's released by the renderer when it has expired.
+   */
+  ParsedParameters(const void *owner, std::shared_ptr<const void> parsed);
+
+  /** The owner this handle belongs to */
+  [[nodiscard]] const void *owner() const;
+
+  /** The renderer specific representation of the parsed parameters */
+  [[nodiscard]] const void *parsed() const;
+
+  /** Whether the handle is not empty */
+  explicit operator bool() const;
+
+private:
+  const void *m_owner = nullptr;
+  std::shared_ptr<const void> m_parsed;
+};
+}  // namespace complate
@@ -18,6 +18,7 @@
 #include <functional>
 #include <string>
 
+#include "nativecall.h"
 #include "value.h"
 
 namespace complate {
@@ -35,6 +36,8 @@ public:
   /** Getter/Setter signatures. */
   using Getter = std::function<Value(void *)>;
   using Setter = std::function<void(void *, const Value &value)>;
+  /** Typed getter signature, see NativeCall. */
+  using Invoker = NativeCall::Invoker;
 
   /** Constructs a readonly Property. */
   Property(std::string name, Getter getter);
@@ -42,11 +45,21 @@ public:
   /** Constructs a writable Property. */
   Property(std::string name, Getter getter, Setter setter);
 
+  /** Constructs a readonly Property with a typed getter. */
+  Property(std::string name, Invoker getter);
+
+  /** Constructs a writable Property with a typed getter. */
+  Property(std::string name, Invoker getter, Setter setter);
+
   Property(const Property &other);
 
   ~Property();
 
-  /** Constructs a readonly Property from a member function pointer. */
+  /**
+   * Constructs a readonly Property from a member function pointer.
+   *
+   * The result is converted directly into a JavaScript value, see NativeCall.
+   */
   template <typename T, typename R>
   Property(std::string name, R (T::*getter)() const)
       : Property(std::move(name), wrap(getter)) {}
@@ -88,6 +101,30 @@ public:
    */
   void set(void *object, const Value &value) const;
 
+  /**
+   * Mark the Property as pure during a render.
+   *
+   * A pure getter returns the same value for the same object as long as a
+   * render is running. The Renderer calls it once per object and render and
+   * reuses the mapped value on further reads, e.g. for computed getters
+   * formatting a date or currency.
+   */
+  void setPure(bool pure);
+
+  /** Check if the Property is pure during a render, see setPure(). */
+  [[nodiscard]] bool pure() const;
+
+  /** Check if this Property was constructed with a typed getter. */
+  [[nodiscard]] bool typed() const;
+
+  /**
+   * Get the value of the Property as result of a NativeCall.
+   *
+   * @param object The pointer to the class instance (this).
+   * @param call Receives the value returned by the getter.
+   */
+  void invoke(void *object, NativeCall &call) const;
+
 private:
   class Impl;
 
@@ -96,19 +133,17 @@ private:
 
   /** Wraps a member function pointer getter to accept void* as this */
   template <typename T, typename R>
-  static Getter wrap(R (T::*getter)() const) {
+  static Invoker wrap(R (T::*getter)() const) {
     static_assert(!std::is_void_v<R>, "A getter have to return non-void");
-    return
-        [getter](void *p) -> Value { return (static_cast<T *>(p)->*getter)(); };
+    return NativeCall::bind(getter);
   }
 
   /** Wraps a non-const member function pointer getter to accept void* as this
    */
   template <typename T, typename R>
-  static Getter wrap(R (T::*getter)()) {
+  static Invoker wrap(R (T::*getter)()) {
     static_assert(!std::is_void_v<R>, "A getter have to return non-void");
-    return
-        [getter](void *p) -> Value { return (static_cast<T *>(p)->*getter)(); };
+    return NativeCall::bind(getter);
   }
 
   /** Wraps a member function pointer setter to accept void* as this */
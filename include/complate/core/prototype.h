@@ -51,6 +51,29 @@ public:
   /** Add a Property */
   void addProperty(const Property &property);
 
+  /**
+   * Mark a Property as pure during a render, see Property::setPure().
+   *
+   * @throws Exception if there is no Property with the name.
+   */
+  void setPure(std::string_view property, bool pure = true);
+
+  /**
+   * Snapshot objects when they are mapped into the engine.
+   *
+   * Instead of an object calling the getters on each read, the Renderer
+   * calls all getters once and creates an object holding their values,
+   * with the same shape for all objects of the Prototype. Use it for
+   * objects whose properties are all read anyway.
+   *
+   * @note Writing a property of a snapshot does not call its setter.
+   * Methods are still called on the native object.
+   */
+  void setSnapshot(bool snapshot);
+
+  /** Check if objects are snapshot when mapped, see setSnapshot(). */
+  [[nodiscard]] bool snapshot() const;
+
   /** Get the name of the Prototype. */
   [[nodiscard]] const std::string &name() const;
 
@@ -63,16 +63,22 @@ public:
     return *this;
   }
 
-  /** Add a Method from a member function without arguments. */
-  template <typename R>
-  PrototypeBuilder<T> &method(std::string name, R (T::*callback)()) {
+  /**
+   * Add a typed Method from a member function.
+   *
+   * The arguments are converted directly into the parameter types,
+   * see NativeCall for the supported types.
+   */
+  template <typename R, typename... A>
+  PrototypeBuilder<T> &method(std::string name, R (T::*callback)(A...)) {
     m_prototype.addMethod({name, callback});
     return *this;
   }
 
-  /** Add a const Method from a member function without arguments. */
-  template <typename R>
-  PrototypeBuilder<T> &method(std::string name, R (T::*callback)() const) {
+  /** Add a typed const Method from a member function. */
+  template <typename R, typename... A>
+  PrototypeBuilder<T> &method(std::string name,
+                              R (T::*callback)(A...) const) {
     m_prototype.addMethod({name, callback});
     return *this;
   }
@@ -94,20 +100,11 @@ public:
     return *this;
   }
 
-  /** Add a Method from a lambda without arguments. */
+  /** Add a typed Method from a lambda without arguments. */
   template <typename R>
   PrototypeBuilder<T> &method(std::string name,
                               std::function<R(T &)> callback) {
-    m_prototype.addMethod(
-        {name, [callback](void *p, const Array &) -> Value {
-           if constexpr (std::is_void_v<
-                             std::invoke_result_t<decltype(callback), T &>>) {
-             std::invoke(callback, *static_cast<T *>(p));
-             return {};
-           } else {
-             return std::invoke(callback, *static_cast<T *>(p));
-           }
-         }});
+    m_prototype.addMethod(Method(name, NativeCall::bind(std::move(callback))));
     return *this;
   }
 
@@ -145,9 +142,8 @@ public:
   template <typename R>
   PrototypeBuilder<T> &property(std::string name,
                                 std::function<R(T &)> getter) {
-    m_prototype.addProperty({name, [getter](void *p) -> Value {
-                               return std::invoke(getter, *static_cast<T *>(p));
-                             }});
+    m_prototype.addProperty(
+        Property(name, NativeCall::bind(std::move(getter))));
     return *this;
   }
 
@@ -156,10 +152,7 @@ public:
   PrototypeBuilder<T> &property(
       std::string name, std::function<R(T &)> getter,
       std::function<void(T &, const Value &)> setter) {
-    m_prototype.addProperty({name,
-                             [getter](void *p) -> Value {
-                               return std::invoke(getter, *static_cast<T *>(p));
-                             },
+    m_prototype.addProperty({name, NativeCall::bind(std::move(getter)),
                              [setter](void *p, const Value &value) {
                                std::invoke(setter, *static_cast<T *>(p), value);
                              }});
@@ -171,10 +164,7 @@ public:
   PrototypeBuilder<T> &property(
       std::string name, R (T::*getter)() const,
       std::function<void(T &, const Value &)> setter) {
-    m_prototype.addProperty({name,
-                             [getter](void *p) {
-                               return std::invoke(getter, *static_cast<T *>(p));
-                             },
+    m_prototype.addProperty({name, NativeCall::bind(getter),
                              [setter](void *p, const Value &value) {
                                std::invoke(setter, *static_cast<T *>(p), value);
                              }});
@@ -185,16 +175,35 @@ public:
   template <typename R>
   PrototypeBuilder<T> &property(std::string name, std::function<R(T &)> getter,
                                 void (T::*setter)(const Value &)) {
-    m_prototype.addProperty({name,
-                             [getter](void *p) -> Value {
-                               return std::invoke(getter, *static_cast<T *>(p));
-                             },
+    m_prototype.addProperty({name, NativeCall::bind(std::move(getter)),
                              [setter](void *p, const Value &value) {
                                std::invoke(setter, *static_cast<T *>(p), value);
                              }});
     return *this;
   }
 
+  /**
+   * Mark an added Property as pure during a render.
+   *
+   * The getter is called once per object and render, see Property::setPure().
+   *
+   * @throws Exception if there is no Property with the name.
+   */
+  PrototypeBuilder<T> &pure(std::string_view property) {
+    m_prototype.setPure(property);
+    return *this;
+  }
+
+  /**
+   * Snapshot the objects when they are mapped into the engine.
+   *
+   * @see Prototype::setSnapshot()
+   */
+  PrototypeBuilder<T> &snapshot(bool enabled = true) {
+    m_prototype.setSnapshot(enabled);
+    return *this;
+  }
+
   /** Build the Prototype. */
   [[nodiscard]] Prototype build() { return m_prototype; }
 
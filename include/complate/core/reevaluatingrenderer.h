@@ -73,6 +73,13 @@ public:
   void render(const std::string &view, const std::string &parameters,
               Stream &stream) override;
 
+  /**
+   * Same as above, but forwards the JSON as string_view without copying it.
+   */
+  void render(const std::string &view, std::string_view parameters,
+              Stream &stream) override;
+  using Renderer::render;
+
 private:
   class Impl;
 
@@ -0,0 +1,113 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "string.h"
+
+namespace complate {
+
+/**
+ * Monotonic memory arena for the Values of a single request.
+ *
+ * Allocations are served from large blocks and never freed individually,
+ * reset() releases all of them at once and keeps the blocks for the next
+ * request. Create one per request, or per thread and reset it after each
+ * render, and copy the strings of your parameters into it. They are stored
+ * as non-owning String, so building a parameter tree doesn't allocate per
+ * string anymore.
+ *
+ * @note Strings taken from the arena are only valid until reset() or the
+ * destruction of the arena, so the Values referencing them must not outlive
+ * the render. It's not thread-safe.
+ *
+ * @example
+ * @code
+ * RenderArena arena;
+ * Object parameters{{"title", arena.string(article.title())}};
+ * renderer.render("Article", parameters, stream);
+ * arena.reset();
+ */
+class RenderArena {
+public:
+  static constexpr std::size_t DEFAULT_BLOCK_SIZE = 64 * 1024;
+
+  /**
+   * Construct a RenderArena.
+   *
+   * @param blockSize Size of the blocks allocations are served from. Larger
+   * allocations get a block of their own.
+   */
+  explicit RenderArena(std::size_t blockSize = DEFAULT_BLOCK_SIZE);
+
+  RenderArena(const RenderArena &) = delete;
+  RenderArena &operator=(const RenderArena &) = delete;
+
+  /**
+   * Allocate uninitialized memory valid until reset().
+   *
+   * @param bytes Number of bytes to allocate.
+   * @param alignment Alignment of the memory, has to be a power of two.
+   * @return Pointer to the memory.
+   */
+  void *allocate(std::size_t bytes,
+                 std::size_t alignment = alignof(std::max_align_t));
+
+  /**
+   * Copy a string into the arena.
+   *
+   * @param str String to copy.
+   * @return View of the copy, valid until reset().
+   */
+  std::string_view copy(std::string_view str);
+
+  /**
+   * Copy a string into the arena and reference it by a String.
+   *
+   * @param str String to copy.
+   * @return String storing a string_view of the copy, valid until reset().
+   */
+  String string(std::string_view str);
+
+  /** Release all allocations at once, the blocks are kept for reuse. */
+  void reset() noexcept;
+
+  /** Number of bytes allocated since the last reset(). */
+  [[nodiscard]] std::size_t used() const noexcept;
+
+  /** Number of bytes of all blocks. */
+  [[nodiscard]] std::size_t capacity() const noexcept;
+
+private:
+  struct Block {
+    std::unique_ptr<char[]> m_data;
+    std::size_t m_size;
+  };
+
+  std::size_t m_blockSize;
+  std::vector<Block> m_blocks;
+  /** Block allocations are served from and the offset within it */
+  std::size_t m_current = 0;
+  std::size_t m_offset = 0;
+  std::size_t m_used = 0;
+
+  void *allocateFrom(Block &block, std::size_t bytes, std::size_t alignment);
+};
+}  // namespace complate
@@ -17,6 +17,7 @@
 
 #include <functional>
 #include <memory>
+#include <string_view>
 
 #include "stream.h"
 #include "value.h"
@@ -68,6 +69,28 @@ public:
   virtual void render(const std::string &view, const std::string &parameters,
                       Stream &stream) = 0;
 
+  /**
+   * Render a view to a Stream using a JSON string_view as parameters.
+   *
+   * By default the parameters are copied into a std::string and rendered by
+   * the overload above. Renderers able to parse them in place override it.
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view. It has to be an JSON Object.
+   * @param stream A stream in which the HTML output will be forwarded.
+   */
+  virtual void render(const std::string &view, std::string_view parameters,
+                      Stream &stream);
+
+  /**
+   * Render a view to a Stream using a JSON string literal as parameters.
+   *
+   * Only there to make literals unambiguous, renders the string_view overload.
+   */
+  void render(const std::string &view, const char *parameters,
+              Stream &stream);
+
   /**
    * Render a view to a String using an Object as parameters.
    *
@@ -89,5 +112,24 @@ public:
    */
   virtual std::string renderToString(const std::string &view,
                                      const std::string &parameters) final;
+
+  /**
+   * Render a view to a String using a JSON string_view as parameters.
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view. It has to be an JSON Object.
+   * @return A string which contains the HTML output.
+   */
+  virtual std::string renderToString(const std::string &view,
+                                     std::string_view parameters) final;
+
+  /**
+   * Render a view to a String using a JSON string literal as parameters.
+   *
+   * Only there to make literals unambiguous, see renderToString() above.
+   */
+  virtual std::string renderToString(const std::string &view,
+                                     const char *parameters) final;
 };
 }  // namespace complate
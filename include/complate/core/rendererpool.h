@@ -0,0 +1,147 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "renderer.h"
+
+namespace complate {
+
+/**
+ * Renderer which holds a bounded pool of Renderer's.
+ *
+ * Every `render()` call checks out an idle Renderer from the pool, renders
+ * with it and returns it afterwards. When no Renderer is idle and the pool
+ * has not reached it's maximum size, a new Renderer is created by the Creator.
+ * Otherwise the calling thread waits until another thread returns a Renderer.
+ *
+ * Unlike `ThreadLocalRenderer` the number of JavaScript contexts is
+ * independent of the number of threads calling `render()`.
+ */
+class RendererPool : public Renderer {
+public:
+  /** Options to size the pool. */
+  struct Options {
+    /** Renderer's created upon construction and never evicted. */
+    std::size_t minSize = 1;
+    /** Maximum number of Renderer's the pool will ever hold. */
+    std::size_t maxSize = 4;
+    /** Evict idle Renderer's above minSize after this time, zero disables. */
+    std::chrono::milliseconds idleTimeout = std::chrono::milliseconds::zero();
+    /** Max time to wait for a Renderer, zero waits forever. */
+    std::chrono::milliseconds waitTimeout = std::chrono::milliseconds::zero();
+  };
+
+  /** Occupancy counters of the pool. */
+  struct Stats {
+    /** Number of Renderer's currently held by the pool. */
+    std::size_t size = 0;
+    /** Number of Renderer's waiting to be checked out. */
+    std::size_t idle = 0;
+    /** Number of Renderer's currently rendering. */
+    std::size_t busy = 0;
+    /** Number of threads currently waiting for a Renderer. */
+    std::size_t waiting = 0;
+    /** Total number of Renderer's created. */
+    std::uint64_t created = 0;
+    /** Total number of Renderer's evicted because they were idle too long. */
+    std::uint64_t evicted = 0;
+    /** Total number of `render()` calls that gave up waiting. */
+    std::uint64_t timeouts = 0;
+  };
+
+  /**
+   * Constructs a RendererPool
+   *
+   * Upon construction `Options::minSize` Renderer's will be created.
+   *
+   * @param creator This function is stored and will be used to create
+   * Renderer's.
+   * @param options Options to size the pool.
+   */
+  explicit RendererPool(Creator creator, Options options);
+
+  /**
+   * Constructs a RendererPool with default Options.
+   *
+   * @param creator This function is stored and will be used to create
+   * Renderer's.
+   */
+  explicit RendererPool(Creator creator);
+
+  ~RendererPool() override;
+
+  /**
+   * Using a pooled Renderer to render a view to a Stream using an Object as
+   * parameters.
+   *
+   * The arguments will be forwarded to a Renderer checked out from the pool.
+   * It will be returned to the pool afterwards, even if rendering throws.
+   *
+   * @note This method allows to achieve "progressive rendering".
+   *
+   * @throws complate::Exception when `Options::waitTimeout` has been exceeded.
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view.
+   * @param stream A stream in which the HTML output will be forwarded.
+   */
+  void render(const std::string &view, const Object &parameters,
+              Stream &stream) override;
+
+  /**
+   * Using a pooled Renderer to render a view to a Stream using a JSON string
+   * as parameters.
+   *
+   * The arguments will be forwarded to a Renderer checked out from the pool.
+   * It will be returned to the pool afterwards, even if rendering throws.
+   *
+   * @note This method allows to achieve "progressive rendering".
+   *
+   * @throws complate::Exception when `Options::waitTimeout` has been exceeded.
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters aka 'the Model' which passed to the
+   * view. It has to be an JSON Object.
+   * @param stream A stream in which the HTML output will be forwarded.
+   */
+  void render(const std::string &view, const std::string &parameters,
+              Stream &stream) override;
+
+  /**
+   * Same as above, but forwards the JSON as string_view without copying it.
+   */
+  void render(const std::string &view, std::string_view parameters,
+              Stream &stream) override;
+  using Renderer::render;
+
+  /** Get the current occupancy counters. */
+  [[nodiscard]] Stats stats() const;
+
+  /** Evict all Renderer's which are idle longer than `Options::idleTimeout`. */
+  void evictIdle();
+
+private:
+  class Impl;
+
+  /** Pointer to implementation */
+  std::unique_ptr<Impl> m_impl;
+};
+}  // namespace complate
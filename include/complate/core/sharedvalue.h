@@ -0,0 +1,74 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+
+#include "types.h"
+
+namespace complate {
+
+/**
+ * Immutable Value shared by reference counting.
+ *
+ * Copying a SharedValue, or a Value holding one, only increments a
+ * reference count. Use it to embed a large sub-model, like a product tree
+ * or translations, into the parameters of many renders without copying it
+ * every time. The mappers convert the referenced Value like it was embedded
+ * directly and Value::is(), Value::get() and Value::optional() see through
+ * it.
+ *
+ * @example
+ * @code
+ * SharedValue catalog(loadCatalog());
+ * renderer.render("Catalog", Object{{"catalog", catalog}}, stream);
+ */
+class SharedValue {
+public:
+  /** Construct a SharedValue owning the given Value. */
+  explicit SharedValue(Value value);
+
+  /** Get the referenced Value. */
+  [[nodiscard]] const Value &value() const;
+
+  /** Get the shared pointer to the referenced Value. */
+  [[nodiscard]] std::shared_ptr<const Value> ptr() const;
+
+  /**
+   * Get the referenced Value for modification, copy on write.
+   *
+   * The Value is copied first, when it's shared with other SharedValues, so
+   * they are not affected by the modification.
+   *
+   * @note The check is not synchronized with copies of this SharedValue
+   * made concurrently by other threads.
+   *
+   * @return Reference to the Value, which is only referenced by this one.
+   */
+  Value &mutate();
+
+  /** Number of SharedValues referencing the same Value. */
+  [[nodiscard]] long useCount() const;
+
+  /** Equal when referencing the same or equal Values. */
+  bool operator==(const SharedValue &other) const;
+
+  bool operator!=(const SharedValue &other) const;
+
+private:
+  std::shared_ptr<Value> m_value;
+};
+}  // namespace complate
@@ -27,10 +27,9 @@ namespace complate {
  * Renderer which creates a Renderer for every thread calls render.
  *
  * The creation of the Renderer is delayed until a thread calls `render()`
- * fot the first time.
- *
- * @attention Due limitations of `thread_local` it' its only be possible to
- * create one `ThreadLocalRenderer` per application.
+ * fot the first time. Every instance has its own Renderer's, so several
+ * instances, e.g. with different bundles, can be used side by side. They are
+ * deleted when their thread exits or the instance is destroyed.
  */
 class ThreadLocalRenderer : public Renderer {
 public:
@@ -42,6 +41,7 @@ public:
    */
   explicit ThreadLocalRenderer(Creator creator);
 
+  /** Deletes the Renderer's of all threads */
   ~ThreadLocalRenderer() override;
 
   /**
@@ -67,7 +67,8 @@ public:
    * string as parameters.
    *
    * The arguments will be forwarded to the Renderer created by Creator.
-   * After the that the newly created Renderer will be deleted.
+   * The Renderer instance will be stored for subsequent calls from calling
+   * thread.
    *
    * @note This method allows to achieve "progressive rendering".
    *
@@ -79,7 +80,14 @@ public:
   void render(const std::string &view, const std::string &parameters,
               Stream &stream) override;
 
-  /** Delete the underlying thread local Renderer instance */
+  /**
+   * Same as above, but forwards the JSON as string_view without copying it.
+   */
+  void render(const std::string &view, std::string_view parameters,
+              Stream &stream) override;
+  using Renderer::render;
+
+  /** Delete the Renderer of the calling thread */
   void reset();
 
 private:
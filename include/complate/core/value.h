@@ -23,6 +23,7 @@
 #include "number.h"
 #include "proxy.h"
 #include "proxyweak.h"
+#include "sharedvalue.h"
 #include "string.h"  // NOLINT
 #include "types.h"
 
@@ -85,6 +86,8 @@ public:
   Value(Proxy proxy);  // NOLINT
   /** Implicit constructed from Proxy */
   Value(ProxyWeak proxyWeak);  // NOLINT
+  /** Implicit constructed from SharedValue, not copying the shared Value */
+  Value(SharedValue shared);  // NOLINT
 
   /** Implicit constructed from const char *. Copied and stored as a string */
   Value(const char *s);  // NOLINT
@@ -99,6 +102,7 @@ public:
     }
   }
 
+  /** Compares the Value referenced by a SharedValue, not the SharedValue. */
   bool operator==(const Value &other) const;
 
   bool operator!=(const Value &other) const;
@@ -178,6 +182,9 @@ public:
 
 private:
   Type m_data;
+
+  /** The data of this Value or the Value referenced by a SharedValue */
+  [[nodiscard]] const Type &data() const;
 };
 
 template <>
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace complate {
+
+/**
+ * Precompiled QuickJS bytecode of a complate source bundle.
+ *
+ * A QuickJsRenderer constructed with bytecode only deserializes it, instead of
+ * parsing and compiling the whole source bundle again.
+ *
+ * @attention Bytecode is only compatible with the QuickJS version it was
+ * compiled with and the byte order of the machine. Don't ship it between
+ * different versions of complate-cpp.
+ */
+class QuickJsBytecode {
+public:
+  /**
+   * Construct from previously compiled bytecode, e.g. read from disk.
+   *
+   * @param data The bytecode as returned by data().
+   */
+  explicit QuickJsBytecode(std::vector<uint8_t> data);
+
+  /**
+   * Compile a complate source bundle to bytecode.
+   *
+   * @throws complate::Exception when the source bundle is malformed.
+   *
+   * @param source The complate JavaScript source bundle with the views.
+   * @return The compiled bytecode.
+   */
+  static QuickJsBytecode compile(const std::string &source);
+
+  /** Get the bytecode, e.g. to write it to disk. */
+  [[nodiscard]] const std::vector<uint8_t> &data() const;
+
+private:
+  std::vector<uint8_t> m_data;
+};
+}  // namespace complate
@@ -55,6 +55,71 @@ public:
    */
   QuickJsRendererBuilder &source(SourceCreator sourceCreator);
 
+  /**
+   * Pass the precompiled bytecode of your views.js bundle.
+   *
+   * When set, it's used instead of the source.
+   *
+   * @param bytecodeObj The precompiled complate JavaScript source bundle.
+   * @return Reference to this builder.
+   */
+  QuickJsRendererBuilder &bytecode(QuickJsBytecode bytecodeObj);
+
+  /**
+   * Compile the source to bytecode once and reuse it.
+   *
+   * The source will be compiled on first use, every renderer built afterwards,
+   * including those created by creator(), only deserialize the bytecode.
+   *
+   * @param enabled Whether the source should be precompiled.
+   * @return Reference to this builder.
+   */
+  QuickJsRendererBuilder &precompile(bool enabled = true);
+
+  /**
+   * Install a native global `htmlEncode(str, attribute)`.
+   *
+   * complate-stream's own `htmlEncode` is scoped to the views.js bundle, so
+   * the bundle has to delegate it to the global one, see the USER_GUIDE. A
+   * binding with the same name takes precedence.
+   *
+   * @see QuickJsRenderer::setHtmlEncode
+   *
+   * @param enabled Whether the native `htmlEncode` should be installed.
+   * @return Reference to this builder.
+   */
+  QuickJsRendererBuilder &htmlEncode(bool enabled = true);
+
+  /**
+   * Map Object parameters lazily.
+   *
+   * @see QuickJsRenderer::setLazyMapping
+   *
+   * @param enabled Whether Object parameters should be mapped lazily.
+   * @return Reference to this builder.
+   */
+  QuickJsRendererBuilder &lazyMapping(bool enabled = true);
+
+  /**
+   * Pass parameters shared with every render.
+   *
+   * @see QuickJsRenderer::setSharedParameter
+   *
+   * @param parameters Fields passed with the parameters of every render.
+   * @return Reference to this builder.
+   */
+  QuickJsRendererBuilder &sharedParameters(Object parameters);
+
+  /**
+   * Install a global `memo(key, component)` backed by the cache.
+   *
+   * @see QuickJsRenderer::setMemoCache
+   *
+   * @param cache Cache shared by every renderer built.
+   * @return Reference to this builder.
+   */
+  QuickJsRendererBuilder &memoCache(std::shared_ptr<MemoCache> cache);
+
   /**
    * Pass your bindings.
    *
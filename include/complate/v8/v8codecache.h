@@ -0,0 +1,87 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <vector>
+
+namespace complate {
+
+/**
+ * Cache for V8 code cache data of compiled source bundles.
+ *
+ * A V8Renderer that shares a V8CodeCache stores the code cache data of its
+ * compiled source bundle in it. Renderers constructed afterwards with the same
+ * source bundle consume it, which skips full parsing and lazy compilation.
+ *
+ * Entries are keyed by keyFor() of the source bundle. You can put() entries
+ * read from disk upon startup and get() them to write them to disk, so even a
+ * restarted process doesn't need to compile the bundle from scratch.
+ *
+ * This class is thread-safe.
+ *
+ * @attention V8 rejects code cache data created by another V8 version or with
+ * other flags. Watch Stats::rejections after upgrading V8.
+ */
+class V8CodeCache {
+public:
+  /** Counters of the cache. */
+  struct Stats {
+    /** Number of compilations which found code cache data. */
+    std::uint64_t hits = 0;
+    /** Number of compilations which found no code cache data. */
+    std::uint64_t misses = 0;
+    /** Number of times V8 rejected the code cache data. */
+    std::uint64_t rejections = 0;
+  };
+
+  using Data = std::vector<std::uint8_t>;
+
+  V8CodeCache();
+  ~V8CodeCache();
+
+  /**
+   * Get the key for a source bundle.
+   *
+   * The key is stable across processes and platforms.
+   */
+  [[nodiscard]] static std::uint64_t keyFor(std::string_view source);
+
+  /** Get code cache data, e.g. to write it to disk. Returns null if absent. */
+  [[nodiscard]] std::shared_ptr<const Data> get(std::uint64_t key) const;
+
+  /** Put code cache data, e.g. read from disk. Replaces existing data. */
+  void put(std::uint64_t key, Data data);
+
+  /** Get code cache data for a compilation and count a hit or a miss. */
+  [[nodiscard]] std::shared_ptr<const Data> consume(std::uint64_t key);
+
+  /** Remove code cache data V8 rejected and count the rejection. */
+  void reject(std::uint64_t key);
+
+  /** Get the current counters. */
+  [[nodiscard]] Stats stats() const;
+
+private:
+  mutable std::mutex m_mutex;
+  std::map<std::uint64_t, std::shared_ptr<const Data>> m_entries;
+  Stats m_stats;
+};
+}  // namespace complate
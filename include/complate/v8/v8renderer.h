@@ -15,12 +15,17 @@
  */
 #pragma once
 
+#include <complate/core/memocache.h>
+#include <complate/core/parsedparameters.h>
 #include <complate/core/prototype.h>
 #include <complate/core/renderer.h>
 #include <complate/core/value.h>
 
 #include <vector>
 
+#include "v8codecache.h"
+#include "v8snapshot.h"
+
 namespace complate {
 
 /**
@@ -53,6 +58,52 @@ public:
   V8Renderer(const std::string &source,
              const std::vector<Prototype> &prototypes, Object bindings);
 
+  /**
+   * Constructs a V8Renderer
+   *
+   * Upon construction an V8 Context will be created an the source
+   * bundle will be evaluated, using and filling the code cache. You need to
+   * create a single complate::V8Platform first or initialize the V8
+   * JavaScript Engine by yourself.
+   *
+   * @param source The complate JavaScript source bundle with the views.
+   * @param prototypes Prototypes for C++ classes to be supported via Proxy.
+   * @param bindings Global variables available in every view.
+   * @param codeCache Cache for the code cache data of the source bundle.
+   */
+  V8Renderer(const std::string &source,
+             const std::vector<Prototype> &prototypes, Object bindings,
+             std::shared_ptr<V8CodeCache> codeCache);
+
+  /**
+   * Constructs a V8Renderer
+   *
+   * Upon construction an V8 Isolate will be booted from the snapshot, which
+   * already contains the evaluated source bundle. You need to create a single
+   * complate::V8Platform first or initialize the V8 JavaScript Engine by
+   * yourself.
+   *
+   * @param snapshot The snapshot of the complate JavaScript source bundle.
+   */
+  explicit V8Renderer(const V8Snapshot &snapshot);
+
+  /**
+   * Constructs a V8Renderer
+   *
+   * Upon construction an V8 Isolate will be booted from the snapshot, which
+   * already contains the evaluated source bundle. You need to create a single
+   * complate::V8Platform first or initialize the V8 JavaScript Engine by
+   * yourself.
+   *
+   * @param snapshot The snapshot of the complate JavaScript source bundle.
+   * @param prototypes Prototypes for C++ classes to be supported via Proxy.
+   * @param bindings Global variables available in every view.
+   */
+  V8Renderer(const V8Snapshot &snapshot,
+             const std::vector<Prototype> &prototypes, Object bindings);
+
+  V8Renderer(V8Renderer &&other) noexcept;
+
   ~V8Renderer() override;
 
   /**
@@ -81,6 +132,119 @@ public:
   void render(const std::string &view, const std::string &parameters,
               Stream &stream) override;
 
+  /**
+   * Render a view to a Stream using a JSON string_view as parameters.
+   *
+   * Same as above, but the JSON is parsed without copying it beforehand.
+   */
+  void render(const std::string &view, std::string_view parameters,
+              Stream &stream) override;
+  using Renderer::render;
+
+  /**
+   * Parse JSON view parameters for being rendered several times.
+   *
+   * The parsed parameters are kept inside this renderer as long as the
+   * returned handle exists. Use it to render the same parameters with several
+   * views in a row, without parsing them each time.
+   *
+   * @note Each render receives a shallow copy of the parsed object, so
+   * fields assigned by a view are not seen by the following renders, but
+   * changes of nested objects are.
+   *
+   * @param parameters The view Parameters aka 'the Model'. It has to be an
+   * JSON Object.
+   * @return Handle to the parsed parameters.
+   */
+  [[nodiscard]] ParsedParameters parse(std::string_view parameters);
+
+  /**
+   * Render a view to a Stream using parsed parameters.
+   *
+   * @note This method allows to achieve "progressive rendering".
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters parsed by this renderer.
+   * @param stream A stream in which the HTML output will be forwarded.
+   */
+  void render(const std::string &view, const ParsedParameters &parameters,
+              Stream &stream);
+
+  /**
+   * Render a view to a String using parsed parameters.
+   *
+   * @param view Name of the view you want to be rendered.
+   * @param parameters The view Parameters parsed by this renderer.
+   * @return A string which contains the HTML output.
+   */
+  std::string renderToString(const std::string &view,
+                             const ParsedParameters &parameters);
+  using Renderer::renderToString;
+
+  /**
+   * Map Object parameters lazily.
+   *
+   * Instead of converting the whole Object parameters before the view runs,
+   * nested Objects are exposed as JS objects which convert a field on first
+   * access and keep it for the remainder of the render. Arrays are converted
+   * when accessed, their Objects lazily again. Use it for large parameters
+   * which are mostly unused by a view.
+   *
+   * @note Enumerating a lazy object lists fields accessed or assigned by the
+   * view first. Fields named like a property of Object.prototype, e.g.
+   * `constructor`, are hidden by it.
+   *
+   * @param enabled Whether Object parameters should be mapped lazily.
+   */
+  void setLazyMapping(bool enabled);
+
+  /**
+   * Share a parameter with every render.
+   *
+   * The value is mapped once into a frozen JS object and passed by reference
+   * as field of the parameters of every following render, unless they
+   * already contain a field with the same name. Use it for mostly static
+   * parameters like configurations, navigation trees or translations.
+   *
+   * @param name Name of the field the value is passed as.
+   * @param value Value of the field, nested Objects and Arrays are frozen.
+   */
+  void setSharedParameter(const std::string &name, Value value);
+
+  /**
+   * Stop sharing a parameter with every render.
+   *
+   * @param name Name of the shared parameter.
+   */
+  void removeSharedParameter(const std::string &name);
+
+  /**
+   * Install a global `memo(key, component)` backed by the cache.
+   *
+   * The HTML of a component is rendered once per key and written to the
+   * Stream on subsequent renders, without running the component. A binding
+   * named `memo` takes precedence.
+   *
+   * @see MemoCache
+   *
+   * @param cache Cache for the HTML, it can be shared by several renderers.
+   */
+  void setMemoCache(std::shared_ptr<MemoCache> cache);
+
+  /**
+   * Install a global native `htmlEncode(str, attribute)`.
+   *
+   * It escapes like the one of complate-stream, but scans the string within
+   * the engine and returns it unchanged when there is nothing to escape.
+   * Other values are converted to a string first. A binding named
+   * `htmlEncode` takes precedence.
+   *
+   * @see HtmlEncode
+   *
+   * @param enabled Whether the native `htmlEncode` should be installed.
+   */
+  void setHtmlEncode(bool enabled);
+
 private:
   class Impl;
 
@@ -55,6 +55,83 @@ public:
   */
   V8RendererBuilder &source(SourceCreator sourceCreator);
 
+  /**
+  * Pass a startup snapshot of your views.js bundle.
+  *
+  * When set, it's used instead of the source.
+  *
+  * @param snapshotObj The snapshot of the complate JavaScript source bundle.
+  * @return Reference to this builder.
+  */
+  V8RendererBuilder &snapshot(V8Snapshot snapshotObj);
+
+  /**
+  * Create a startup snapshot of the source once and reuse it.
+  *
+  * The snapshot will be created on first use, every renderer built afterwards,
+  * including those created by creator(), boot from the snapshot.
+  *
+  * @param enabled Whether a snapshot should be created.
+  * @return Reference to this builder.
+  */
+  V8RendererBuilder &createSnapshot(bool enabled = true);
+
+  /**
+  * Pass a code cache shared by the renderers.
+  *
+  * Every renderer compiling the source consumes the code cache data of it or
+  * stores it for the renderers created afterwards. It's not used when booting
+  * from a snapshot.
+  *
+  * @param cache Cache for the code cache data of the source bundle.
+  * @return Reference to this builder.
+  */
+  V8RendererBuilder &codeCache(std::shared_ptr<V8CodeCache> cache);
+
+  /**
+  * Install a native global `htmlEncode(str, attribute)`.
+  *
+  * complate-stream's own `htmlEncode` is scoped to the views.js bundle, so
+  * the bundle has to delegate it to the global one, see the USER_GUIDE. A
+  * binding with the same name takes precedence.
+  *
+  * @see V8Renderer::setHtmlEncode
+  *
+  * @param enabled Whether the native `htmlEncode` should be installed.
+  * @return Reference to this builder.
+  */
+  V8RendererBuilder &htmlEncode(bool enabled = true);
+
+  /**
+  * Map Object parameters lazily.
+  *
+  * @see V8Renderer::setLazyMapping
+  *
+  * @param enabled Whether Object parameters should be mapped lazily.
+  * @return Reference to this builder.
+  */
+  V8RendererBuilder &lazyMapping(bool enabled = true);
+
+  /**
+  * Pass parameters shared with every render.
+  *
+  * @see V8Renderer::setSharedParameter
+  *
+  * @param parameters Fields passed with the parameters of every render.
+  * @return Reference to this builder.
+  */
+  V8RendererBuilder &sharedParameters(Object parameters);
+
+  /**
+   * Install a global `memo(key, component)` backed by the cache.
+   *
+   * @see V8Renderer::setMemoCache
+   *
+   * @param cache Cache shared by every renderer built.
+   * @return Reference to this builder.
+   */
+  V8RendererBuilder &memoCache(std::shared_ptr<MemoCache> cache);
+
   /**
   * Pass your bindings.
   *
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace complate {
+
+/**
+ * V8 startup snapshot of a complate source bundle.
+ *
+ * The snapshot contains a context in which the source bundle has already been
+ * evaluated, including the `render` function. A V8Renderer constructed with a
+ * snapshot boots its isolate from it, instead of parsing, compiling and
+ * running the whole source bundle again.
+ *
+ * Copies of a V8Snapshot share the same blob.
+ *
+ * @attention A snapshot is only compatible with the V8 version and the flags
+ * it was created with. Your source bundle must not access bindings while it is
+ * evaluated, because they are only installed after the snapshot was booted.
+ */
+class V8Snapshot {
+public:
+  /**
+   * Construct from a previously created snapshot blob, e.g. read from disk.
+   *
+   * @param data The snapshot blob as returned by data().
+   */
+  explicit V8Snapshot(std::vector<char> data);
+
+  /**
+   * Create a snapshot of a complate source bundle.
+   *
+   * You need to create a single complate::V8Platform first or initialize the
+   * V8 JavaScript Engine by yourself.
+   *
+   * @throws complate::Exception when the source bundle is malformed.
+   *
+   * @param source The complate JavaScript source bundle with the views.
+   * @return The snapshot.
+   */
+  static V8Snapshot create(const std::string &source);
+
+  /** Get the snapshot blob, e.g. to write it to disk. */
+  [[nodiscard]] const std::vector<char> &data() const;
+
+private:
+  std::shared_ptr<const std::vector<char>> m_data;
+};
+}  // namespace complate
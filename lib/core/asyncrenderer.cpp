@@ -0,0 +1,263 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/asyncrenderer.h>
+#include <complate/core/stringstream.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace complate;
+using namespace std;
+
+class AsyncRenderer::Impl {
+public:
+  using Task = function<void(Renderer &)>;
+
+  Impl(const Creator &creator, Options options) : m_started(Clock::now()) {
+    size_t threads = options.threads;
+    if (threads == 0) {
+      threads = max<size_t>(thread::hardware_concurrency(), 1);
+    }
+    for (size_t i = 0; i < threads; ++i) {
+      m_workers.push_back(make_unique<Worker>());
+      m_workers.back()->m_renderer = creator();
+    }
+    for (size_t i = 0; i < threads; ++i) {
+      m_workers[i]->m_thread = thread([this, i] { work(i); });
+    }
+  }
+
+  ~Impl() {
+    {
+      lock_guard<mutex> guard(m_mutex);
+      m_stopping = true;
+    }
+    m_available.notify_all();
+    for (auto &worker : m_workers) {
+      worker->m_thread.join();
+    }
+  }
+
+  template <typename Parameters>
+  future<string> renderAsync(string view, Parameters parameters) {
+    auto promise = make_shared<std::promise<string>>();
+    auto result = promise->get_future();
+    submit([promise, view = move(view),
+            parameters = move(parameters)](Renderer &renderer) {
+      try {
+        auto stream = StringStream();
+        renderer.render(view, parameters, stream);
+        promise->set_value(stream.str());
+      } catch (...) {
+        promise->set_exception(current_exception());
+      }
+    });
+    return result;
+  }
+
+  template <typename Parameters>
+  void renderAsync(string view, Parameters parameters, Stream &stream,
+                   Completion completion) {
+    submit([view = move(view), parameters = move(parameters), &stream,
+            completion = move(completion)](Renderer &renderer) {
+      exception_ptr exception;
+      try {
+        renderer.render(view, parameters, stream);
+      } catch (...) {
+        exception = current_exception();
+      }
+      if (completion) {
+        completion(exception);
+      }
+    });
+  }
+
+  template <typename Parameters>
+  void render(const string &view, const Parameters &parameters,
+              Stream &stream) {
+    std::promise<void> promise;
+    submit([&](Renderer &renderer) {
+      try {
+        renderer.render(view, parameters, stream);
+        promise.set_value();
+      } catch (...) {
+        promise.set_exception(current_exception());
+      }
+    });
+    promise.get_future().get();
+  }
+
+  size_t threads() const { return m_workers.size(); }
+
+  Stats stats() const {
+    const auto elapsed = Clock::now() - m_started;
+    Stats s;
+    for (const auto &worker : m_workers) {
+      WorkerStats w;
+      {
+        lock_guard<mutex> guard(worker->m_mutex);
+        w.queued = worker->m_tasks.size();
+      }
+      w.executed = worker->m_executed;
+      w.stolen = worker->m_stolen;
+      w.busy = chrono::nanoseconds(worker->m_busy);
+      w.utilization =
+          (elapsed.count() > 0) ? (double)w.busy.count() / elapsed.count() : 0;
+      s.queued += w.queued;
+      s.executed += w.executed;
+      s.stolen += w.stolen;
+      s.workers.push_back(w);
+    }
+    return s;
+  }
+
+private:
+  using Clock = chrono::steady_clock;
+
+  struct Worker {
+    mutable mutex m_mutex;
+    /** Oldest task at the front, taken first by the owner and thieves */
+    deque<Task> m_tasks;
+    unique_ptr<Renderer> m_renderer;
+    thread m_thread;
+    atomic<uint64_t> m_executed{0};
+    atomic<uint64_t> m_stolen{0};
+    atomic<int64_t> m_busy{0};
+  };
+
+  const Clock::time_point m_started;
+  vector<unique_ptr<Worker>> m_workers;
+  atomic<size_t> m_next{0};
+  /** Guards sleeping and waking up workers only */
+  mutex m_mutex;
+  condition_variable m_available;
+  /** Tasks submitted but not yet taken, counted before being queued */
+  atomic<size_t> m_pending{0};
+  bool m_stopping = false;
+
+  void submit(Task task) {
+    {
+      lock_guard<mutex> guard(m_mutex);
+      ++m_pending;
+    }
+    Worker &worker = *m_workers[m_next++ % m_workers.size()];
+    {
+      lock_guard<mutex> guard(worker.m_mutex);
+      worker.m_tasks.push_back(move(task));
+    }
+    m_available.notify_one();
+  }
+
+  static bool take(Worker &worker, Task &task) {
+    lock_guard<mutex> guard(worker.m_mutex);
+    if (worker.m_tasks.empty()) {
+      return false;
+    }
+    task = move(worker.m_tasks.front());
+    worker.m_tasks.pop_front();
+    return true;
+  }
+
+  /** Take a task from the own queue or steal one from the others */
+  bool take(size_t index, Task &task) {
+    Worker &own = *m_workers[index];
+    if (take(own, task)) {
+      return true;
+    }
+    for (size_t i = 1; i < m_workers.size(); ++i) {
+      if (take(*m_workers[(index + i) % m_workers.size()], task)) {
+        ++own.m_stolen;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /** Runs tasks until stopped and all queued tasks are done */
+  void work(size_t index) {
+    Worker &worker = *m_workers[index];
+    while (true) {
+      Task task;
+      if (take(index, task)) {
+        --m_pending;
+        const auto start = Clock::now();
+        task(*worker.m_renderer);
+        worker.m_busy += chrono::duration_cast<chrono::nanoseconds>(
+                             Clock::now() - start)
+                             .count();
+        ++worker.m_executed;
+        continue;
+      }
+
+      unique_lock<mutex> lock(m_mutex);
+      m_available.wait(lock, [this] { return m_stopping || m_pending > 0; });
+      if (m_stopping && m_pending == 0) {
+        return;
+      }
+    }
+  }
+};
+
+AsyncRenderer::AsyncRenderer(const Creator &creator, Options options)
+    : m_impl(make_unique<Impl>(creator, options)) {}
+
+AsyncRenderer::AsyncRenderer(const Creator &creator)
+    : AsyncRenderer(creator, Options()) {}
+
+AsyncRenderer::~AsyncRenderer() = default;
+
+future<string> AsyncRenderer::renderAsync(string view, Object parameters) {
+  return m_impl->renderAsync(move(view), move(parameters));
+}
+
+future<string> AsyncRenderer::renderAsync(string view, string parameters) {
+  return m_impl->renderAsync(move(view), move(parameters));
+}
+
+void AsyncRenderer::renderAsync(string view, Object parameters, Stream &stream,
+                                Completion completion) {
+  m_impl->renderAsync(move(view), move(parameters), stream, move(completion));
+}
+
+void AsyncRenderer::renderAsync(string view, string parameters, Stream &stream,
+                                Completion completion) {
+  m_impl->renderAsync(move(view), move(parameters), stream, move(completion));
+}
+
+void AsyncRenderer::render(const string &view, const Object &parameters,
+                           Stream &stream) {
+  m_impl->render(view, parameters, stream);
+}
+
+void AsyncRenderer::render(const string &view, const string &parameters,
+                           Stream &stream) {
+  m_impl->render(view, string_view(parameters), stream);
+}
+
+void AsyncRenderer::render(const string &view, string_view parameters,
+                           Stream &stream) {
+  m_impl->render(view, parameters, stream);
+}
+
+size_t AsyncRenderer::threads() const { return m_impl->threads(); }
+
+AsyncRenderer::Stats AsyncRenderer::stats() const { return m_impl->stats(); }
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/bufferedstream.h>
+
+#include <string>
+
+using namespace complate;
+using namespace std;
+
+class BufferedStream::Impl {
+public:
+  Impl(Stream &dest, Options options)
+      : m_dest(dest),
+        m_options(options),
+        m_lastFlush(Clock::now()) {
+    m_buffer.reserve(m_options.bufferSize);
+  }
+
+  ~Impl() {
+    try {
+      drain();
+    } catch (...) {
+      /* Destructors must not throw */
+    }
+  }
+
+  void write(const char *str, int len) {
+    const auto size = static_cast<size_t>(len);
+    if (m_buffer.size() + size > m_options.bufferSize) {
+      forward();
+    }
+    if (size >= m_options.bufferSize) {
+      m_dest.write(str, len);
+    } else {
+      m_buffer.append(str, size);
+    }
+  }
+
+  void writeln(const char *str, int len) {
+    write(str, len);
+    write("\n", 1);
+  }
+
+  void flush() {
+    if (m_buffer.size() >= m_options.flushThreshold || intervalElapsed()) {
+      drain();
+    }
+  }
+
+  void drain() {
+    forward();
+    m_dest.flush();
+    m_lastFlush = Clock::now();
+  }
+
+private:
+  using Clock = chrono::steady_clock;
+
+  Stream &m_dest;
+  Options m_options;
+  string m_buffer;
+  Clock::time_point m_lastFlush;
+
+  void forward() {
+    if (!m_buffer.empty()) {
+      m_dest.write(m_buffer.data(), static_cast<int>(m_buffer.size()));
+      m_buffer.clear();
+    }
+  }
+
+  [[nodiscard]] bool intervalElapsed() const {
+    return m_options.flushInterval != chrono::milliseconds::zero() &&
+           Clock::now() - m_lastFlush >= m_options.flushInterval;
+  }
+};
+
+BufferedStream::BufferedStream(Stream &dest, Options options)
+    : m_impl(make_unique<Impl>(dest, options)) {}
+
+BufferedStream::BufferedStream(Stream &dest)
+    : BufferedStream(dest, Options()) {}
+
+BufferedStream::~BufferedStream() = default;
+
+void BufferedStream::write(const char *str, int len) {
+  m_impl->write(str, len);
+}
+
+void BufferedStream::writeln(const char *str, int len) {
+  m_impl->writeln(str, len);
+}
+
+void BufferedStream::flush() { m_impl->flush(); }
+
+void BufferedStream::drain() { m_impl->drain(); }
@@ -0,0 +1,327 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/cachingrenderer.h>
+#include <complate/core/sharedvalue.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <mutex>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+using namespace complate;
+using namespace std;
+
+namespace {
+/** Forwards to a Stream while capturing the output */
+class CapturingStream : public Stream {
+public:
+  explicit CapturingStream(Stream &stream) : m_stream(stream) {}
+
+  void write(const char *str, int len) override {
+    m_stream.write(str, len);
+    m_output.append(str, len);
+  }
+
+  void writeln(const char *str, int len) override {
+    m_stream.writeln(str, len);
+    m_output.append(str, len);
+    m_output += '\n';
+  }
+
+  void flush() override { m_stream.flush(); }
+
+  string &output() { return m_output; }
+
+private:
+  Stream &m_stream;
+  string m_output;
+};
+
+/** Whether the output may depend on more than the content of the value */
+// NOLINTNEXTLINE(misc-no-recursion)
+bool isCacheable(const Value &value) {
+  if (value.holds<SharedValue>()) {
+    return isCacheable(value.exactly<SharedValue>().value());
+  } else if (value.holds<Array>()) {
+    const auto &array = value.exactly<Array>();
+    return all_of(array.begin(), array.end(), isCacheable);
+  } else if (value.holds<Object>()) {
+    const auto &object = value.exactly<Object>();
+    return all_of(object.begin(), object.end(),
+                  [](const auto &field) { return isCacheable(field.second); });
+  }
+  return !value.holds<Function>() && !value.holds<Proxy>() &&
+         !value.holds<ProxyWeak>();
+}
+
+template <typename T>
+void appendBytes(const T &data, string &key) {
+  key.append(reinterpret_cast<const char *>(&data), sizeof(data));
+}
+
+void appendString(string_view str, string &key) {
+  appendBytes(str.size(), key);
+  key.append(str);
+}
+
+void appendKey(const Value &value, string &key);
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void appendKey(const Object &object, string &key) {
+  key += 'o';
+  appendBytes(object.size(), key);
+  for (const auto &[name, field] : object) {
+    appendString(name, key);
+    appendKey(field, key);
+  }
+}
+
+/**
+ * Append a cacheable value to the key. Unlike JSON, each alternative gets
+ * its own tag and doubles are written with all their bits, so values which
+ * might be rendered differently never share a key.
+ */
+// NOLINTNEXTLINE(misc-no-recursion)
+void appendKey(const Value &value, string &key) {
+  if (value.holds<SharedValue>()) {
+    key += 'S';
+    appendKey(value.exactly<SharedValue>().value(), key);
+  } else if (value.holds<Undefined>()) {
+    key += 'U';
+  } else if (value.holds<Null>()) {
+    key += 'N';
+  } else if (value.holds<Bool>()) {
+    key += (value.exactly<Bool>()) ? 'T' : 'F';
+  } else if (value.holds<Number>()) {
+    const auto &number = value.exactly<Number>();
+    if (number.holds<int32_t>()) {
+      key += 'i';
+      appendBytes(number.exactly<int32_t>(), key);
+    } else if (number.holds<uint32_t>()) {
+      key += 'u';
+      appendBytes(number.exactly<uint32_t>(), key);
+    } else if (number.holds<int64_t>()) {
+      key += 'l';
+      appendBytes(number.exactly<int64_t>(), key);
+    } else {
+      key += 'd';
+      appendBytes(number.exactly<double>(), key);
+    }
+  } else if (value.holds<String>()) {
+    key += 's';
+    appendString(value.exactly<String>().get<string_view>(), key);
+  } else if (value.holds<Array>()) {
+    const auto &array = value.exactly<Array>();
+    key += 'a';
+    appendBytes(array.size(), key);
+    for (const auto &element : array) {
+      appendKey(element, key);
+    }
+  } else if (value.holds<Object>()) {
+    appendKey(value.exactly<Object>(), key);
+  }
+}
+}  // namespace
+
+class CachingRenderer::Impl {
+public:
+  Impl(const Creator &creator, Options options)
+      : m_renderer(creator()),
+        m_options(options),
+        m_shards(max<size_t>(m_options.shards, 1)) {
+    m_shardBytes = m_options.maxBytes / m_shards.size();
+  }
+
+  void render(const string &view, const Object &parameters, Stream &stream) {
+    if (!all_of(parameters.begin(), parameters.end(), [](const auto &field) {
+          return isCacheable(field.second);
+        })) {
+      m_renderer->render(view, parameters, stream);
+      return;
+    }
+
+    string key = keyFor(view, 'O');
+    appendKey(parameters, key);
+    render(move(key), stream,
+           [&](Stream &s) { m_renderer->render(view, parameters, s); });
+  }
+
+  void render(const string &view, string_view parameters, Stream &stream) {
+    string key = keyFor(view, 'J');
+    key.append(parameters.data(), parameters.size());
+    render(move(key), stream,
+           [&](Stream &s) { m_renderer->render(view, parameters, s); });
+  }
+
+  Stats stats() const {
+    Stats s;
+    for (const auto &shard : m_shards) {
+      lock_guard<mutex> guard(shard.m_mutex);
+      s.entries += shard.m_lookup.size();
+      s.bytes += shard.m_bytes;
+      s.hits += shard.m_hits;
+      s.misses += shard.m_misses;
+      s.evicted += shard.m_evicted;
+      s.expired += shard.m_expired;
+    }
+    return s;
+  }
+
+  void clear() {
+    for (auto &shard : m_shards) {
+      list<Entry> entries; /* deleted outside of the lock */
+      lock_guard<mutex> guard(shard.m_mutex);
+      shard.m_lookup.clear();
+      entries.swap(shard.m_entries);
+      shard.m_bytes = 0;
+    }
+  }
+
+private:
+  using Clock = chrono::steady_clock;
+
+  struct Entry {
+    string m_key;
+    shared_ptr<const string> m_output;
+    Clock::time_point m_expires;
+  };
+
+  struct Shard {
+    mutable mutex m_mutex;
+    /** Most recently used at the front, keys point into the entries */
+    list<Entry> m_entries;
+    unordered_map<string_view, list<Entry>::iterator> m_lookup;
+    size_t m_bytes = 0;
+    uint64_t m_hits = 0;
+    uint64_t m_misses = 0;
+    uint64_t m_evicted = 0;
+    uint64_t m_expired = 0;
+  };
+
+  unique_ptr<Renderer> m_renderer;
+  Options m_options;
+  vector<Shard> m_shards;
+  size_t m_shardBytes;
+
+  static string keyFor(const string &view, char kind) {
+    string key;
+    key.reserve(view.size() + 64);
+    key.append(view);
+    key += '\0';
+    key += kind;
+    return key;
+  }
+
+  template <typename Render>
+  void render(string key, Stream &stream, const Render &render) {
+    auto &shard = m_shards[hash<string_view>()(key) % m_shards.size()];
+
+    shared_ptr<const string> cached = lookup(shard, key);
+    if (cached) {
+      stream.write(cached->data(), (int)cached->size());
+      return;
+    }
+
+    CapturingStream capturing(stream);
+    render(capturing);
+    insert(shard, move(key), move(capturing.output()));
+  }
+
+  shared_ptr<const string> lookup(Shard &shard, const string &key) {
+    lock_guard<mutex> guard(shard.m_mutex);
+    auto it = shard.m_lookup.find(key);
+    if (it == shard.m_lookup.end()) {
+      ++shard.m_misses;
+      return nullptr;
+    }
+
+    auto entry = it->second;
+    if (m_options.ttl != chrono::milliseconds::zero() &&
+        Clock::now() >= entry->m_expires) {
+      erase(shard, entry);
+      ++shard.m_expired;
+      ++shard.m_misses;
+      return nullptr;
+    }
+
+    shard.m_entries.splice(shard.m_entries.begin(), shard.m_entries, entry);
+    ++shard.m_hits;
+    return entry->m_output;
+  }
+
+  void insert(Shard &shard, string key, string output) {
+    const size_t bytes = key.size() + output.size();
+    if (bytes > m_shardBytes) {
+      return;
+    }
+
+    auto cached = make_shared<const string>(move(output));
+    lock_guard<mutex> guard(shard.m_mutex);
+    auto it = shard.m_lookup.find(key);
+    if (it != shard.m_lookup.end()) {
+      erase(shard, it->second);
+    }
+    while (shard.m_bytes + bytes > m_shardBytes) {
+      erase(shard, prev(shard.m_entries.end()));
+      ++shard.m_evicted;
+    }
+
+    shard.m_entries.push_front(
+        {move(key), move(cached), Clock::now() + m_options.ttl});
+    const auto entry = shard.m_entries.begin();
+    shard.m_lookup.emplace(entry->m_key, entry);
+    shard.m_bytes += bytes;
+  }
+
+  static void erase(Shard &shard, list<Entry>::iterator entry) {
+    shard.m_bytes -= entry->m_key.size() + entry->m_output->size();
+    shard.m_lookup.erase(entry->m_key);
+    shard.m_entries.erase(entry);
+  }
+};
+
+CachingRenderer::CachingRenderer(const Creator &creator, Options options)
+    : m_impl(make_unique<Impl>(creator, options)) {}
+
+CachingRenderer::CachingRenderer(const Creator &creator)
+    : CachingRenderer(creator, Options()) {}
+
+CachingRenderer::~CachingRenderer() = default;
+
+void CachingRenderer::render(const string &view, const Object &parameters,
+                             Stream &stream) {
+  m_impl->render(view, parameters, stream);
+}
+
+void CachingRenderer::render(const string &view, const string &parameters,
+                             Stream &stream) {
+  m_impl->render(view, string_view(parameters), stream);
+}
+
+void CachingRenderer::render(const string &view, string_view parameters,
+                             Stream &stream) {
+  m_impl->render(view, parameters, stream);
+}
+
+CachingRenderer::Stats CachingRenderer::stats() const {
+  return m_impl->stats();
+}
+
+void CachingRenderer::clear() { m_impl->clear(); }
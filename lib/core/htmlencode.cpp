@@ -0,0 +1,102 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/htmlencode.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace complate;
+using namespace std;
+
+namespace {
+inline bool needsEscape(char c, bool attribute) {
+  return c == '&' || c == '<' || c == '>' ||
+         (attribute && (c == '\'' || c == '"'));
+}
+
+inline string_view entityFor(char c) {
+  switch (c) {
+    case '&':
+      return "&amp;";
+    case '<':
+      return "&lt;";
+    case '>':
+      return "&gt;";
+    case '"':
+      return "&quot;";
+    default:
+      return "&#x27;";
+  }
+}
+}  // namespace
+
+size_t HtmlEncode::find(string_view str, bool attribute) {
+  const char *data = str.data();
+  const size_t size = str.size();
+  size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i amp = _mm_set1_epi8('&');
+  const __m128i lt = _mm_set1_epi8('<');
+  const __m128i gt = _mm_set1_epi8('>');
+  const __m128i apos = _mm_set1_epi8('\'');
+  const __m128i quot = _mm_set1_epi8('"');
+  for (; i + 16 <= size; i += 16) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    __m128i matches = _mm_or_si128(
+        _mm_cmpeq_epi8(chunk, amp),
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, lt), _mm_cmpeq_epi8(chunk, gt)));
+    if (attribute) {
+      matches = _mm_or_si128(
+          matches, _mm_or_si128(_mm_cmpeq_epi8(chunk, apos),
+                                _mm_cmpeq_epi8(chunk, quot)));
+    }
+    const int mask = _mm_movemask_epi8(matches);
+    if (mask != 0) {
+      return i + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+  }
+#endif
+
+  for (; i < size; ++i) {
+    if (needsEscape(data[i], attribute)) {
+      return i;
+    }
+  }
+  return string_view::npos;
+}
+
+string HtmlEncode::encode(string_view str, bool attribute) {
+  size_t pos = find(str, attribute);
+  if (pos == string_view::npos) {
+    return string(str);
+  }
+
+  string result;
+  result.reserve(str.size() + str.size() / 8 + 8);
+  size_t last = 0;
+  while (pos != string_view::npos) {
+    result.append(str.substr(last, pos - last));
+    result.append(entityFor(str[pos]));
+    last = pos + 1;
+    const size_t next = find(str.substr(last), attribute);
+    pos = (next != string_view::npos) ? last + next : string_view::npos;
+  }
+  result.append(str.substr(last));
+  return result;
+}
@@ -0,0 +1,574 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/exception.h>
+#include <complate/core/json.h>
+
+#include <clocale>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+using namespace complate;
+using namespace std;
+
+namespace {
+const int MAX_DEPTH = 512;
+
+/** Decimal point of the LC_NUMERIC locale, which strtod and printf use */
+string_view decimalPoint() {
+  const char *point = localeconv()->decimal_point;
+  return (point != nullptr && *point != '\0') ? point : ".";
+}
+
+/** Position of the first '"', '\\' or control character, size otherwise */
+size_t findSpecial(const char *data, size_t size) {
+  size_t i = 0;
+
+#if defined(__SSE2__)
+  const __m128i quot = _mm_set1_epi8('"');
+  const __m128i backslash = _mm_set1_epi8('\\');
+  const __m128i control = _mm_set1_epi8(0x1f);
+  for (; i + 16 <= size; i += 16) {
+    const __m128i chunk =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + i));
+    /* Unsigned chunk <= 0x1f, when the minimum is the chunk itself */
+    const __m128i matches = _mm_or_si128(
+        _mm_or_si128(_mm_cmpeq_epi8(chunk, quot),
+                     _mm_cmpeq_epi8(chunk, backslash)),
+        _mm_cmpeq_epi8(_mm_min_epu8(chunk, control), chunk));
+    const int mask = _mm_movemask_epi8(matches);
+    if (mask != 0) {
+      return i + __builtin_ctz(static_cast<unsigned>(mask));
+    }
+  }
+#endif
+
+  for (; i < size; ++i) {
+    const auto c = static_cast<unsigned char>(data[i]);
+    if (c == '"' || c == '\\' || c < 0x20) {
+      return i;
+    }
+  }
+  return size;
+}
+
+inline bool isDigit(char c) { return c >= '0' && c <= '9'; }
+
+void appendUtf8(string &out, uint32_t cp) {
+  if (cp < 0x80) {
+    out += static_cast<char>(cp);
+  } else if (cp < 0x800) {
+    out += static_cast<char>(0xc0 | (cp >> 6));
+    out += static_cast<char>(0x80 | (cp & 0x3f));
+  } else if (cp < 0x10000) {
+    out += static_cast<char>(0xe0 | (cp >> 12));
+    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+    out += static_cast<char>(0x80 | (cp & 0x3f));
+  } else {
+    out += static_cast<char>(0xf0 | (cp >> 18));
+    out += static_cast<char>(0x80 | ((cp >> 12) & 0x3f));
+    out += static_cast<char>(0x80 | ((cp >> 6) & 0x3f));
+    out += static_cast<char>(0x80 | (cp & 0x3f));
+  }
+}
+
+class Parser {
+public:
+  Parser(string_view json, bool view)
+      : m_begin(json.data()),
+        m_pos(json.data()),
+        m_end(json.data() + json.size()),
+        m_view(view) {}
+
+  Value parseDocument() {
+    Value value = parseValue(0);
+    skipWhitespace();
+    if (m_pos != m_end) {
+      fail();
+    }
+    return value;
+  }
+
+private:
+  const char *m_begin;
+  const char *m_pos;
+  const char *m_end;
+  bool m_view;
+  string m_decoded;
+
+  [[noreturn]] void fail() const {
+    if (m_pos >= m_end) {
+      throw Exception("SyntaxError: Unexpected end of JSON input");
+    }
+    const string msg = string("SyntaxError: Unexpected token '") + *m_pos +
+                       "' in JSON at position " + to_string(m_pos - m_begin);
+    throw Exception(msg.c_str());
+  }
+
+  void skipWhitespace() {
+    while (m_pos < m_end &&
+           (*m_pos == ' ' || *m_pos == '\n' || *m_pos == '\r' ||
+            *m_pos == '\t')) {
+      ++m_pos;
+    }
+  }
+
+  void expect(char c) {
+    if (m_pos == m_end || *m_pos != c) {
+      fail();
+    }
+    ++m_pos;
+  }
+
+  void expect(string_view literal) {
+    for (char c : literal) {
+      expect(c);
+    }
+  }
+
+  // NOLINTNEXTLINE(misc-no-recursion)
+  Value parseValue(int depth) {
+    skipWhitespace();
+    if (m_pos == m_end) {
+      fail();
+    }
+
+    switch (*m_pos) {
+      case '{':
+        return parseObject(depth + 1);
+      case '[':
+        return parseArray(depth + 1);
+      case '"':
+        return parseString();
+      case 't':
+        expect("true");
+        return true;
+      case 'f':
+        expect("false");
+        return false;
+      case 'n':
+        expect("null");
+        return nullptr;
+      default:
+        return parseNumber();
+    }
+  }
+
+  // NOLINTNEXTLINE(misc-no-recursion)
+  Value parseObject(int depth) {
+    if (depth > MAX_DEPTH) {
+      throw Exception("SyntaxError: JSON is nested too deeply");
+    }
+    ++m_pos;
+
+    Object object;
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == '}') {
+      ++m_pos;
+      return object;
+    }
+    while (true) {
+      skipWhitespace();
+      if (m_pos == m_end || *m_pos != '"') {
+        fail();
+      }
+      bool escaped = false;
+      string key(scanString(escaped));
+      skipWhitespace();
+      expect(':');
+      Value value = parseValue(depth);
+      object.insert_or_assign(move(key), move(value));
+
+      skipWhitespace();
+      if (m_pos < m_end && *m_pos == ',') {
+        ++m_pos;
+      } else {
+        expect('}');
+        return object;
+      }
+    }
+  }
+
+  // NOLINTNEXTLINE(misc-no-recursion)
+  Value parseArray(int depth) {
+    if (depth > MAX_DEPTH) {
+      throw Exception("SyntaxError: JSON is nested too deeply");
+    }
+    ++m_pos;
+
+    Array array;
+    skipWhitespace();
+    if (m_pos < m_end && *m_pos == ']') {
+      ++m_pos;
+      return array;
+    }
+    while (true) {
+      array.emplace_back(parseValue(depth));
+
+      skipWhitespace();
+      if (m_pos < m_end && *m_pos == ',') {
+        ++m_pos;
+      } else {
+        expect(']');
+        return array;
+      }
+    }
+  }
+
+  Value parseString() {
+    bool escaped = false;
+    string_view str = scanString(escaped);
+    if (m_view && !escaped) {
+      return str;
+    }
+    return string(str);
+  }
+
+  /** The string within the JSON text or decoded into m_decoded */
+  string_view scanString(bool &escaped) {
+    ++m_pos;
+    const char *start = m_pos;
+    const size_t n = findSpecial(m_pos, m_end - m_pos);
+    m_pos += n;
+    if (m_pos < m_end && *m_pos == '"') {
+      ++m_pos;
+      escaped = false;
+      return {start, n};
+    }
+
+    escaped = true;
+    m_decoded.assign(start, n);
+    while (m_pos < m_end) {
+      const char c = *m_pos;
+      if (c == '"') {
+        ++m_pos;
+        return m_decoded;
+      } else if (c == '\\') {
+        ++m_pos;
+        decodeEscape();
+      } else if (static_cast<unsigned char>(c) < 0x20) {
+        fail();
+      } else {
+        const size_t k = findSpecial(m_pos, m_end - m_pos);
+        m_decoded.append(m_pos, k);
+        m_pos += k;
+      }
+    }
+    fail();
+  }
+
+  void decodeEscape() {
+    if (m_pos == m_end) {
+      fail();
+    }
+    switch (*m_pos++) {
+      case '"':
+        m_decoded += '"';
+        break;
+      case '\\':
+        m_decoded += '\\';
+        break;
+      case '/':
+        m_decoded += '/';
+        break;
+      case 'b':
+        m_decoded += '\b';
+        break;
+      case 'f':
+        m_decoded += '\f';
+        break;
+      case 'n':
+        m_decoded += '\n';
+        break;
+      case 'r':
+        m_decoded += '\r';
+        break;
+      case 't':
+        m_decoded += '\t';
+        break;
+      case 'u':
+        decodeUnicode();
+        break;
+      default:
+        --m_pos;
+        fail();
+    }
+  }
+
+  void decodeUnicode() {
+    uint32_t cp = parseHex4();
+    if (cp >= 0xd800 && cp <= 0xdbff && m_end - m_pos >= 6 &&
+        m_pos[0] == '\\' && m_pos[1] == 'u') {
+      const char *high = m_pos;
+      m_pos += 2;
+      const uint32_t low = parseHex4();
+      if (low >= 0xdc00 && low <= 0xdfff) {
+        cp = 0x10000 + ((cp - 0xd800) << 10) + (low - 0xdc00);
+      } else {
+        m_pos = high;
+      }
+    }
+    /* A lone surrogate can't be encoded as UTF-8 */
+    if (cp >= 0xd800 && cp <= 0xdfff) {
+      cp = 0xfffd;
+    }
+    appendUtf8(m_decoded, cp);
+  }
+
+  uint32_t parseHex4() {
+    uint32_t cp = 0;
+    for (int i = 0; i < 4; ++i, ++m_pos) {
+      if (m_pos == m_end) {
+        fail();
+      }
+      const char c = *m_pos;
+      cp <<= 4;
+      if (isDigit(c)) {
+        cp |= c - '0';
+      } else if (c >= 'a' && c <= 'f') {
+        cp |= c - 'a' + 10;
+      } else if (c >= 'A' && c <= 'F') {
+        cp |= c - 'A' + 10;
+      } else {
+        fail();
+      }
+    }
+    return cp;
+  }
+
+  Value parseNumber() {
+    const char *start = m_pos;
+    const bool negative = *m_pos == '-';
+    if (negative) {
+      ++m_pos;
+    }
+    if (m_pos < m_end && *m_pos == '0') {
+      ++m_pos;
+    } else {
+      skipDigits();
+    }
+
+    bool integral = true;
+    if (m_pos < m_end && *m_pos == '.') {
+      integral = false;
+      ++m_pos;
+      skipDigits();
+    }
+    if (m_pos < m_end && (*m_pos == 'e' || *m_pos == 'E')) {
+      integral = false;
+      ++m_pos;
+      if (m_pos < m_end && (*m_pos == '+' || *m_pos == '-')) {
+        ++m_pos;
+      }
+      skipDigits();
+    }
+
+    /* Up to 10 digits can't overflow int64, -0 has to stay a double */
+    const size_t len = m_pos - start;
+    if (integral && len - negative <= 10) {
+      int64_t number = 0;
+      for (const char *p = start + negative; p < m_pos; ++p) {
+        number = number * 10 + (*p - '0');
+      }
+      number = (negative) ? -number : number;
+      if (negative && number == 0) {
+        return -0.0;
+      } else if (number >= numeric_limits<int32_t>::min() &&
+                 number <= numeric_limits<int32_t>::max()) {
+        return static_cast<int32_t>(number);
+      }
+      return static_cast<double>(number);
+    }
+
+    /* strtod expects the decimal point of the locale */
+    const string_view point = decimalPoint();
+    const auto *dot = static_cast<const char *>(memchr(start, '.', len));
+    char buffer[64];
+    string longNumber;
+    const char *cstr = buffer;
+    if (len < sizeof(buffer) && (dot == nullptr || point == ".")) {
+      memcpy(buffer, start, len);
+      buffer[len] = '\0';
+    } else {
+      longNumber.assign(start, len);
+      if (dot != nullptr) {
+        longNumber.replace(dot - start, 1, point);
+      }
+      cstr = longNumber.c_str();
+    }
+    return strtod(cstr, nullptr);
+  }
+
+  void skipDigits() {
+    if (m_pos == m_end || !isDigit(*m_pos)) {
+      fail();
+    }
+    while (m_pos < m_end && isDigit(*m_pos)) {
+      ++m_pos;
+    }
+  }
+};
+
+/** Whether a field holding the value is omitted like by JSON.stringify */
+bool omitted(const Value &value) {
+  if (value.holds<SharedValue>()) {
+    return omitted(value.exactly<SharedValue>().value());
+  }
+  return value.holds<Undefined>() || value.holds<Function>() ||
+         value.holds<Proxy>() || value.holds<ProxyWeak>();
+}
+
+void writeString(string_view str, string &out) {
+  out += '"';
+  size_t i = 0;
+  while (true) {
+    const size_t n = findSpecial(str.data() + i, str.size() - i);
+    out.append(str.data() + i, n);
+    i += n;
+    if (i == str.size()) {
+      break;
+    }
+
+    const char c = str[i++];
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\b':
+        out += "\\b";
+        break;
+      case '\f':
+        out += "\\f";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        char escape[8];
+        snprintf(escape, sizeof(escape), "\\u%04x",
+                 static_cast<unsigned char>(c));
+        out += escape;
+    }
+  }
+  out += '"';
+}
+
+void writeNumber(const Number &number, string &out) {
+  if (number.holds<int32_t>()) {
+    out += to_string(number.exactly<int32_t>());
+  } else if (number.holds<uint32_t>()) {
+    out += to_string(number.exactly<uint32_t>());
+  } else if (number.holds<int64_t>()) {
+    out += to_string(number.exactly<int64_t>());
+  } else {
+    const double d = number.exactly<double>();
+    if (!isfinite(d)) {
+      out += "null";
+      return;
+    }
+    /* Shortest of both which reads back as the same double */
+    char buffer[32];
+    snprintf(buffer, sizeof(buffer), "%.15g", d);
+    if (strtod(buffer, nullptr) != d) {
+      snprintf(buffer, sizeof(buffer), "%.17g", d);
+    }
+    /* snprintf writes the decimal point of the locale */
+    const string_view text(buffer);
+    const string_view point = decimalPoint();
+    const size_t pos = (point == ".") ? string_view::npos : text.find(point);
+    if (pos == string_view::npos) {
+      out += text;
+    } else {
+      out += text.substr(0, pos);
+      out += '.';
+      out += text.substr(pos + point.size());
+    }
+  }
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+void write(const Value &value, string &out) {
+  if (value.holds<SharedValue>()) {
+    write(value.exactly<SharedValue>().value(), out);
+  } else if (value.holds<Bool>()) {
+    out += (value.exactly<Bool>()) ? "true" : "false";
+  } else if (value.holds<Number>()) {
+    writeNumber(value.exactly<Number>(), out);
+  } else if (value.holds<String>()) {
+    writeString(value.exactly<String>().get<string_view>(), out);
+  } else if (value.holds<Array>()) {
+    out += '[';
+    bool first = true;
+    for (const auto &element : value.exactly<Array>()) {
+      if (!first) {
+        out += ',';
+      }
+      first = false;
+      write(element, out);
+    }
+    out += ']';
+  } else if (value.holds<Object>()) {
+    out += '{';
+    bool first = true;
+    for (const auto &[k, v] : value.exactly<Object>()) {
+      if (omitted(v)) {
+        continue;
+      }
+      if (!first) {
+        out += ',';
+      }
+      first = false;
+      writeString(k, out);
+      out += ':';
+      write(v, out);
+    }
+    out += '}';
+  } else {
+    out += "null";
+  }
+}
+}  // namespace
+
+Value Json::parse(string_view json) {
+  return Parser(json, false).parseDocument();
+}
+
+Value Json::parseView(string_view json) {
+  return Parser(json, true).parseDocument();
+}
+
+string Json::stringify(const Value &value) {
+  string out;
+  stringify(value, out);
+  return out;
+}
+
+void Json::stringify(const Value &value, string &out) { write(value, out); }
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/memocache.h>
+
+using namespace complate;
+using namespace std;
+
+MemoCache::MemoCache(size_t maxBytes) : m_maxBytes(maxBytes) {}
+
+shared_ptr<const string> MemoCache::get(string_view key) const {
+  lock_guard<mutex> guard(m_mutex);
+  auto it = m_lookup.find(key);
+  if (it == m_lookup.end()) {
+    return nullptr;
+  }
+  m_entries.splice(m_entries.begin(), m_entries, it->second);
+  return it->second->m_html;
+}
+
+bool MemoCache::put(string_view key, string html) {
+  const size_t bytes = key.size() + html.size();
+  if (bytes > m_maxBytes) {
+    return false;
+  }
+
+  auto stored = make_shared<const string>(move(html));
+  lock_guard<mutex> guard(m_mutex);
+  auto it = m_lookup.find(key);
+  if (it != m_lookup.end()) {
+    erase(it->second);
+  }
+  while (m_bytes + bytes > m_maxBytes) {
+    erase(prev(m_entries.end()));
+  }
+
+  m_entries.push_front({string(key), move(stored)});
+  const auto entry = m_entries.begin();
+  m_lookup.emplace(entry->m_key, entry);
+  m_bytes += bytes;
+  return true;
+}
+
+void MemoCache::invalidate(string_view key) {
+  lock_guard<mutex> guard(m_mutex);
+  auto it = m_lookup.find(key);
+  if (it != m_lookup.end()) {
+    erase(it->second);
+  }
+}
+
+void MemoCache::clear() {
+  lock_guard<mutex> guard(m_mutex);
+  m_lookup.clear();
+  m_entries.clear();
+  m_bytes = 0;
+}
+
+size_t MemoCache::size() const {
+  lock_guard<mutex> guard(m_mutex);
+  return m_entries.size();
+}
+
+size_t MemoCache::bytes() const {
+  lock_guard<mutex> guard(m_mutex);
+  return m_bytes;
+}
+
+string_view MemoCache::script() {
+  /* replay() writes directly to the renderer's Stream and returns true, for
+   * other streams, like the capture of an outer memo, it returns the HTML. */
+  return R"((function(cache) {
+  return function memo(key, component) {
+    return function(stream, options, callback) {
+      var html = cache.replay(stream, key);
+      if (html !== undefined) {
+        if (html !== true) {
+          stream.write(html);
+        }
+        callback();
+        return;
+      }
+      html = "";
+      var capture = {
+        write: function(str) { html += str; stream.write(str); },
+        writeln: function(str) { html += str + "\n"; stream.writeln(str); },
+        flush: function() { stream.flush(); }
+      };
+      var element = (component.length === 0) ? component() : component;
+      element(capture, options, function() {
+        cache.store(key, html);
+        callback();
+      });
+    };
+  };
+}))";
+}
+
+void MemoCache::erase(list<Entry>::iterator entry) {
+  m_bytes -= entry->m_key.size() + entry->m_html->size();
+  m_lookup.erase(entry->m_key);
+  m_entries.erase(entry);
+}
@@ -22,21 +22,52 @@ class Method::Impl {
 public:
   Impl(string name, Callback callback)
       : m_name(move(name)), m_callback(move(callback)) {}
+  Impl(string name, Invoker invoker)
+      : m_name(move(name)), m_invoker(move(invoker)) {}
 
   [[nodiscard]] const string &name() const { return m_name; }
 
   Value apply(void *object, const Array &args) {
-    return (object) ? invoke(m_callback, object, args) : Value();
+    if (!object) {
+      return {};
+    } else if (m_invoker) {
+      ValueCall call(args);
+      m_invoker(object, call);
+      return call.value();
+    } else {
+      return std::invoke(m_callback, object, args);
+    }
+  }
+
+  [[nodiscard]] bool typed() const { return (bool)m_invoker; }
+
+  void invoke(void *object, NativeCall &call) {
+    if (!object) {
+      call.returnUndefined();
+    } else if (m_invoker) {
+      m_invoker(object, call);
+    } else {
+      Array args;
+      args.reserve(call.argc());
+      for (int i = 0; i < call.argc(); ++i) {
+        args.emplace_back(call.toValue(i));
+      }
+      call.returnValue(std::invoke(m_callback, object, args));
+    }
   }
 
 private:
   std::string m_name;
   Callback m_callback;
+  Invoker m_invoker;
 };
 
 Method::Method(string name, Callback callback)
     : m_impl(make_unique<Impl>(move(name), move(callback))) {}
 
+Method::Method(string name, Invoker invoker)
+    : m_impl(make_unique<Impl>(move(name), move(invoker))) {}
+
 Method::Method(const Method &other)
     : m_impl(make_unique<Impl>(*other.m_impl)) {}
 
@@ -47,3 +78,9 @@ const std::string &Method::name() const { return m_impl->name(); }
 Value Method::apply(void *object, const Array &args) const {
   return m_impl->apply(object, args);
 }
+
+bool Method::typed() const { return m_impl->typed(); }
+
+void Method::invoke(void *object, NativeCall &call) const {
+  m_impl->invoke(object, call);
+}
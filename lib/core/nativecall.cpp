@@ -0,0 +1,72 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/nativecall.h>
+
+#include <limits>
+
+using namespace complate;
+using namespace std;
+
+ValueCall::ValueCall(const Array &args) : m_args(args) {}
+
+const Value &ValueCall::value() const { return m_value; }
+
+int ValueCall::argc() const { return (int)m_args.size(); }
+
+bool ValueCall::failed() const { return false; }
+
+bool ValueCall::toBool(int index) {
+  return toValue(index).optional<Bool>().value_or(false);
+}
+
+int32_t ValueCall::toInt32(int index) {
+  return toValue(index).optional<int32_t>().value_or(0);
+}
+
+int64_t ValueCall::toInt64(int index) {
+  return toValue(index).optional<int64_t>().value_or(0);
+}
+
+double ValueCall::toDouble(int index) {
+  return toValue(index).optional<double>().value_or(
+      numeric_limits<double>::quiet_NaN());
+}
+
+string ValueCall::toString(int index) {
+  return toValue(index).optional<string>().value_or(string());
+}
+
+Value ValueCall::toValue(int index) {
+  return (index < argc()) ? m_args[index] : Value();
+}
+
+void ValueCall::returnUndefined() { m_value = Value(); }
+
+void ValueCall::returnNull() { m_value = nullptr; }
+
+void ValueCall::returnBool(bool value) { m_value = value; }
+
+void ValueCall::returnInt32(int32_t value) { m_value = value; }
+
+void ValueCall::returnUint32(uint32_t value) { m_value = value; }
+
+void ValueCall::returnInt64(int64_t value) { m_value = value; }
+
+void ValueCall::returnDouble(double value) { m_value = value; }
+
+void ValueCall::returnString(string_view value) { m_value = string(value); }
+
+void ValueCall::returnValue(const Value &value) { m_value = value; }
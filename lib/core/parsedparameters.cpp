@@ -0,0 +1,29 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/parsedparameters.h>
+
+using namespace complate;
+using namespace std;
+
+ParsedParameters::ParsedParameters(const void *owner,
+                                   shared_ptr<const void> parsed)
+    : m_owner(owner), m_parsed(move(parsed)) {}
+
+const void *ParsedParameters::owner() const { return m_owner; }
+
+const void *ParsedParameters::parsed() const { return m_parsed.get(); }
+
+ParsedParameters::operator bool() const { return m_parsed != nullptr; }
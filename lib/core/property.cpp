@@ -24,23 +24,56 @@ public:
       : m_name(move(name)), m_getter(move(getter)) {}
   Impl(string name, Getter getter, Setter setter)
       : m_name(move(name)), m_getter(move(getter)), m_setter(move(setter)) {}
+  Impl(string name, Invoker invoker)
+      : m_name(move(name)), m_invoker(move(invoker)) {}
+  Impl(string name, Invoker invoker, Setter setter)
+      : m_name(move(name)),
+        m_invoker(move(invoker)),
+        m_setter(move(setter)) {}
 
   [[nodiscard]] const string &name() const { return m_name; }
 
   Value get(void *object) const {
-    return (object) ? invoke(m_getter, object) : Value();
+    if (!object) {
+      return {};
+    } else if (m_invoker) {
+      static const Array noArgs;
+      ValueCall call(noArgs);
+      m_invoker(object, call);
+      return call.value();
+    } else {
+      return std::invoke(m_getter, object);
+    }
   }
 
   void set(void *object, const Value &value) const {
     if (object && m_setter.has_value()) {
-      invoke(m_setter.value(), object, value);
+      std::invoke(m_setter.value(), object, value);
+    }
+  }
+
+  void setPure(bool pure) { m_pure = pure; }
+
+  [[nodiscard]] bool pure() const { return m_pure; }
+
+  [[nodiscard]] bool typed() const { return (bool)m_invoker; }
+
+  void invoke(void *object, NativeCall &call) const {
+    if (!object) {
+      call.returnUndefined();
+    } else if (m_invoker) {
+      m_invoker(object, call);
+    } else {
+      call.returnValue(std::invoke(m_getter, object));
     }
   }
 
 private:
   string m_name;
   Getter m_getter;
+  Invoker m_invoker;
   optional<Setter> m_setter;
+  bool m_pure = false;
 };
 
 Property::Property(string name, Getter getter)
@@ -49,6 +82,12 @@ Property::Property(string name, Getter getter)
 Property::Property(string name, Getter getter, Setter setter)
     : m_impl(make_unique<Impl>(move(name), move(getter), move(setter))) {}
 
+Property::Property(string name, Invoker getter)
+    : m_impl(make_unique<Impl>(move(name), move(getter))) {}
+
+Property::Property(string name, Invoker getter, Setter setter)
+    : m_impl(make_unique<Impl>(move(name), move(getter), move(setter))) {}
+
 Property::Property(const Property &other)
     : m_impl(make_unique<Impl>(*other.m_impl)) {}
 
@@ -61,3 +100,13 @@ Value Property::get(void *object) const { return m_impl->get(object); }
 void Property::set(void *object, const Value &value) const {
   return m_impl->set(object, value);
 }
+
+void Property::setPure(bool pure) { m_impl->setPure(pure); }
+
+bool Property::pure() const { return m_impl->pure(); }
+
+bool Property::typed() const { return m_impl->typed(); }
+
+void Property::invoke(void *object, NativeCall &call) const {
+  m_impl->invoke(object, call);
+}
@@ -13,6 +13,7 @@
  *  See the License for the specific language governing permissions and
  *  limitations under the License.
  */
+#include <complate/core/exception.h>
 #include <complate/core/prototype.h>
 
 #include <map>
@@ -33,6 +34,21 @@ public:
     m_properties.push_back(property);
   }
 
+  void setPure(string_view property, bool pure) {
+    for (auto &p : m_properties) {
+      if (p.name() == property) {
+        p.setPure(pure);
+        return;
+      }
+    }
+    const string msg = "unknown Property '" + string(property) + "'";
+    throw Exception(msg.c_str());
+  }
+
+  void setSnapshot(bool snapshot) { m_snapshot = snapshot; }
+
+  [[nodiscard]] bool snapshot() const { return m_snapshot; }
+
   [[nodiscard]] const vector<Method> &methods() const { return m_methods; }
 
   [[nodiscard]] optional<Method> method(string_view name) const {
@@ -61,6 +77,7 @@ private:
   string m_name;
   vector<Method> m_methods;
   vector<Property> m_properties;
+  bool m_snapshot = false;
 };
 
 Prototype::Prototype(string name) : m_impl(make_unique<Impl>(move(name))) {}
@@ -76,6 +93,14 @@ void Prototype::addProperty(const Property &property) {
   m_impl->addProperty(property);
 }
 
+void Prototype::setPure(string_view property, bool pure) {
+  m_impl->setPure(property, pure);
+}
+
+void Prototype::setSnapshot(bool snapshot) { m_impl->setSnapshot(snapshot); }
+
+bool Prototype::snapshot() const { return m_impl->snapshot(); }
+
 const string &Prototype::name() const { return m_impl->name(); }
 
 const vector<Method> &Prototype::methods() const { return m_impl->methods(); }
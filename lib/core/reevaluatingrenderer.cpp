@@ -26,7 +26,7 @@ public:
     m_creator()->render(view, parameters, stream);
   }
 
-  void render(const string &view, const string &parameters, Stream &stream) {
+  void render(const string &view, string_view parameters, Stream &stream) {
     m_creator()->render(view, parameters, stream);
   }
 
@@ -45,5 +45,10 @@ void ReEvaluatingRenderer::render(const string &view, const Object &parameters,
 
 void ReEvaluatingRenderer::render(const string &view, const string &parameters,
                                   Stream &stream) {
+  m_impl->render(view, string_view(parameters), stream);
+}
+
+void ReEvaluatingRenderer::render(const string &view, string_view parameters,
+                                  Stream &stream) {
   m_impl->render(view, parameters, stream);
 }
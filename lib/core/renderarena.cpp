@@ -0,0 +1,79 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/renderarena.h>
+
+#include <cstdint>
+#include <cstring>
+
+using namespace complate;
+using namespace std;
+
+RenderArena::RenderArena(size_t blockSize) : m_blockSize(blockSize) {}
+
+void *RenderArena::allocate(size_t bytes, size_t alignment) {
+  for (; m_current < m_blocks.size(); ++m_current, m_offset = 0) {
+    void *ptr = allocateFrom(m_blocks[m_current], bytes, alignment);
+    if (ptr) {
+      return ptr;
+    }
+  }
+
+  const size_t size = max(m_blockSize, bytes + alignment);
+  m_blocks.push_back(Block{make_unique<char[]>(size), size});
+  m_current = m_blocks.size() - 1;
+  m_offset = 0;
+  return allocateFrom(m_blocks.back(), bytes, alignment);
+}
+
+string_view RenderArena::copy(string_view str) {
+  if (str.empty()) {
+    return {};
+  }
+  auto data = static_cast<char *>(allocate(str.size(), 1));
+  memcpy(data, str.data(), str.size());
+  return {data, str.size()};
+}
+
+String RenderArena::string(string_view str) { return String(copy(str)); }
+
+void RenderArena::reset() noexcept {
+  m_current = 0;
+  m_offset = 0;
+  m_used = 0;
+}
+
+size_t RenderArena::used() const noexcept { return m_used; }
+
+size_t RenderArena::capacity() const noexcept {
+  size_t capacity = 0;
+  for (const auto &block : m_blocks) {
+    capacity += block.m_size;
+  }
+  return capacity;
+}
+
+void *RenderArena::allocateFrom(Block &block, size_t bytes, size_t alignment) {
+  auto base = reinterpret_cast<uintptr_t>(block.m_data.get());
+  uintptr_t aligned = (base + m_offset + alignment - 1) & ~(alignment - 1);
+  size_t offset = aligned - base;
+  if (offset + bytes > block.m_size) {
+    return nullptr;
+  }
+
+  m_offset = offset + bytes;
+  m_used += bytes;
+  return reinterpret_cast<void *>(aligned);
+}
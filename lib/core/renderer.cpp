@@ -30,3 +30,23 @@ string Renderer::renderToString(const string &view, const string &parameters) {
   render(view, parameters, stream);
   return stream.str();
 }
+
+string Renderer::renderToString(const string &view, string_view parameters) {
+  auto stream = StringStream();
+  render(view, parameters, stream);
+  return stream.str();
+}
+
+string Renderer::renderToString(const string &view, const char *parameters) {
+  return renderToString(view, string_view(parameters));
+}
+
+void Renderer::render(const string &view, string_view parameters,
+                      Stream &stream) {
+  render(view, string(parameters), stream);
+}
+
+void Renderer::render(const string &view, const char *parameters,
+                      Stream &stream) {
+  render(view, string_view(parameters), stream);
+}
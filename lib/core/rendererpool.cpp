@@ -0,0 +1,202 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/exception.h>
+#include <complate/core/rendererpool.h>
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+using namespace complate;
+using namespace std;
+
+class RendererPool::Impl {
+public:
+  Impl(Creator creator, Options options)
+      : m_creator(move(creator)), m_options(options) {
+    m_options.maxSize = max<size_t>(m_options.maxSize, 1);
+    m_options.minSize = min(m_options.minSize, m_options.maxSize);
+    for (size_t i = 0; i < m_options.minSize; ++i) {
+      m_idle.push_back({m_creator(), Clock::now()});
+    }
+    m_size = m_idle.size();
+    m_created = m_idle.size();
+  }
+
+  void render(const string &view, const Object &parameters, Stream &stream) {
+    Lease lease(*this);
+    lease->render(view, parameters, stream);
+  }
+
+  void render(const string &view, string_view parameters, Stream &stream) {
+    Lease lease(*this);
+    lease->render(view, parameters, stream);
+  }
+
+  Stats stats() const {
+    lock_guard<mutex> guard(m_mutex);
+    Stats s;
+    s.size = m_size;
+    s.idle = m_idle.size();
+    s.busy = m_size - m_idle.size();
+    s.waiting = m_waiting;
+    s.created = m_created;
+    s.evicted = m_evicted;
+    s.timeouts = m_timeouts;
+    return s;
+  }
+
+  void evictIdle() {
+    deque<Idle> evicted;
+    {
+      lock_guard<mutex> guard(m_mutex);
+      evicted = takeExpired(Clock::now());
+    }
+    /* Renderer's are deleted here, outside of the lock. */
+  }
+
+private:
+  using Clock = chrono::steady_clock;
+
+  struct Idle {
+    unique_ptr<Renderer> m_renderer;
+    Clock::time_point m_since;
+  };
+
+  /** Checks a Renderer out on construction and returns it on destruction. */
+  class Lease {
+  public:
+    explicit Lease(Impl &pool) : m_pool(pool), m_renderer(pool.checkout()) {}
+    ~Lease() { m_pool.checkin(move(m_renderer)); }
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+
+    Renderer *operator->() const { return m_renderer.get(); }
+
+  private:
+    Impl &m_pool;
+    unique_ptr<Renderer> m_renderer;
+  };
+
+  Creator m_creator;
+  Options m_options;
+  mutable mutex m_mutex;
+  condition_variable m_available;
+  /** Most recently returned Renderer at the back, oldest at the front. */
+  deque<Idle> m_idle;
+  size_t m_size = 0;
+  size_t m_waiting = 0;
+  uint64_t m_created = 0;
+  uint64_t m_evicted = 0;
+  uint64_t m_timeouts = 0;
+
+  unique_ptr<Renderer> checkout() {
+    deque<Idle> evicted; /* declared first to be deleted outside of the lock */
+    unique_lock<mutex> lock(m_mutex);
+    evicted = takeExpired(Clock::now());
+
+    if (m_idle.empty() && m_size >= m_options.maxSize) {
+      ++m_waiting;
+      auto available = [this] {
+        return !m_idle.empty() || m_size < m_options.maxSize;
+      };
+      bool success = true;
+      if (m_options.waitTimeout == chrono::milliseconds::zero()) {
+        m_available.wait(lock, available);
+      } else {
+        success = m_available.wait_for(lock, m_options.waitTimeout, available);
+      }
+      --m_waiting;
+      if (!success) {
+        ++m_timeouts;
+        throw Exception("RendererPool: timeout waiting for a Renderer");
+      }
+    }
+
+    if (!m_idle.empty()) {
+      unique_ptr<Renderer> renderer = move(m_idle.back().m_renderer);
+      m_idle.pop_back();
+      return renderer;
+    }
+
+    ++m_size;
+    lock.unlock();
+    try {
+      unique_ptr<Renderer> renderer = m_creator();
+      lock.lock();
+      ++m_created;
+      return renderer;
+    } catch (...) {
+      lock.lock();
+      --m_size;
+      m_available.notify_one();
+      throw;
+    }
+  }
+
+  void checkin(unique_ptr<Renderer> renderer) {
+    {
+      lock_guard<mutex> guard(m_mutex);
+      m_idle.push_back({move(renderer), Clock::now()});
+    }
+    m_available.notify_one();
+  }
+
+  /** Must be called with m_mutex locked. */
+  deque<Idle> takeExpired(Clock::time_point now) {
+    deque<Idle> expired;
+    if (m_options.idleTimeout == chrono::milliseconds::zero()) {
+      return expired;
+    }
+
+    while (!m_idle.empty() && m_size > m_options.minSize &&
+           now - m_idle.front().m_since >= m_options.idleTimeout) {
+      expired.push_back(move(m_idle.front()));
+      m_idle.pop_front();
+      --m_size;
+      ++m_evicted;
+    }
+    return expired;
+  }
+};
+
+RendererPool::RendererPool(Creator creator, Options options)
+    : m_impl(make_unique<Impl>(move(creator), options)) {}
+
+RendererPool::RendererPool(Creator creator)
+    : RendererPool(move(creator), Options()) {}
+
+RendererPool::~RendererPool() = default;
+
+void RendererPool::render(const string &view, const Object &parameters,
+                          Stream &stream) {
+  m_impl->render(view, parameters, stream);
+}
+
+void RendererPool::render(const string &view, const string &parameters,
+                          Stream &stream) {
+  m_impl->render(view, string_view(parameters), stream);
+}
+
+void RendererPool::render(const string &view, string_view parameters,
+                          Stream &stream) {
+  m_impl->render(view, parameters, stream);
+}
+
+RendererPool::Stats RendererPool::stats() const { return m_impl->stats(); }
+
+void RendererPool::evictIdle() { m_impl->evictIdle(); }
@@ -0,0 +1,44 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/sharedvalue.h>
+#include <complate/core/value.h>
+
+using namespace complate;
+using namespace std;
+
+SharedValue::SharedValue(Value value)
+    : m_value(make_shared<Value>(move(value))) {}
+
+const Value &SharedValue::value() const { return *m_value; }
+
+shared_ptr<const Value> SharedValue::ptr() const { return m_value; }
+
+Value &SharedValue::mutate() {
+  if (m_value.use_count() > 1) {
+    m_value = make_shared<Value>(*m_value);
+  }
+  return *m_value;
+}
+
+long SharedValue::useCount() const { return m_value.use_count(); }
+
+bool SharedValue::operator==(const SharedValue &other) const {
+  return m_value == other.m_value || *m_value == *other.m_value;
+}
+
+bool SharedValue::operator!=(const SharedValue &other) const {
+  return !operator==(other);
+}
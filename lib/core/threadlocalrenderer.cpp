@@ -16,38 +16,121 @@
 #if !defined(__MINGW32__) && !defined(__MINGW64__)
 #include <complate/core/threadlocalrenderer.h>
 
+#include <atomic>
+#include <map>
+#include <mutex>
+#include <set>
+#include <vector>
+
 using namespace complate;
 using namespace std;
 
-thread_local unique_ptr<Renderer> COMPLATE_THREAD_LOCAL_RENDERER_INSTANCE =
-    nullptr;
+namespace {
+/** Renderer's of the calling thread by the id of their ThreadLocalRenderer */
+struct ThreadRenderers {
+  mutex m_mutex;
+  map<uint64_t, unique_ptr<Renderer>> m_renderers;
+
+  ~ThreadRenderers();
+};
+
+/** Threads holding a Renderer by the id of their ThreadLocalRenderer */
+struct Registry {
+  /** Also guards the removal of other threads' Renderer's */
+  mutex m_mutex;
+  map<uint64_t, set<ThreadRenderers *>> m_threads;
+};
+
+/** Never deleted, instances may be destroyed after static destruction */
+Registry &registry() {
+  static auto *instance = new Registry();
+  return *instance;
+}
+
+atomic<uint64_t> NEXT_ID{1};
+thread_local ThreadRenderers THREAD_RENDERERS;
+
+ThreadRenderers::~ThreadRenderers() {
+  Registry &reg = registry();
+  lock_guard<mutex> guard(reg.m_mutex);
+  for (const auto &[id, renderer] : m_renderers) {
+    auto it = reg.m_threads.find(id);
+    if (it != reg.m_threads.end()) {
+      it->second.erase(this);
+    }
+  }
+}
+}  // namespace
 
 class ThreadLocalRenderer::Impl {
 public:
-  explicit Impl(Creator creator) : m_creator(move(creator)) {}
+  explicit Impl(Creator creator)
+      : m_creator(move(creator)), m_id(NEXT_ID++) {}
+
+  /** Deletes the Renderer's of all threads */
+  ~Impl() {
+    Registry &reg = registry();
+    vector<unique_ptr<Renderer>> renderers; /* deleted outside of the locks */
+    lock_guard<mutex> guard(reg.m_mutex);
+    auto it = reg.m_threads.find(m_id);
+    if (it == reg.m_threads.end()) {
+      return;
+    }
+    for (ThreadRenderers *thread : it->second) {
+      lock_guard<mutex> threadGuard(thread->m_mutex);
+      auto renderer = thread->m_renderers.find(m_id);
+      renderers.push_back(move(renderer->second));
+      thread->m_renderers.erase(renderer);
+    }
+    reg.m_threads.erase(it);
+  }
 
   void render(const string &view, const Object &parameters, Stream &stream) {
-    getOrCreateRenderer()->render(view, parameters, stream);
+    getOrCreateRenderer().render(view, parameters, stream);
   }
 
-  void render(const string &view, const string &parameters, Stream &stream) {
-    getOrCreateRenderer()->render(view, parameters, stream);
+  void render(const string &view, string_view parameters, Stream &stream) {
+    getOrCreateRenderer().render(view, parameters, stream);
   }
 
-  static void reset() {
-    COMPLATE_THREAD_LOCAL_RENDERER_INSTANCE.reset(nullptr);
+  void reset() {
+    ThreadRenderers &thread = THREAD_RENDERERS;
+    Registry &reg = registry();
+    unique_ptr<Renderer> renderer; /* deleted outside of the locks */
+    lock_guard<mutex> guard(reg.m_mutex);
+    lock_guard<mutex> threadGuard(thread.m_mutex);
+    auto it = thread.m_renderers.find(m_id);
+    if (it != thread.m_renderers.end()) {
+      renderer = move(it->second);
+      thread.m_renderers.erase(it);
+      reg.m_threads[m_id].erase(&thread);
+    }
   }
 
-  unique_ptr<Renderer> &getOrCreateRenderer() {
-    if (!COMPLATE_THREAD_LOCAL_RENDERER_INSTANCE) {
-      COMPLATE_THREAD_LOCAL_RENDERER_INSTANCE = m_creator();
+  Renderer &getOrCreateRenderer() {
+    ThreadRenderers &thread = THREAD_RENDERERS;
+    {
+      lock_guard<mutex> threadGuard(thread.m_mutex);
+      auto it = thread.m_renderers.find(m_id);
+      if (it != thread.m_renderers.end()) {
+        return *it->second;
+      }
     }
 
-    return COMPLATE_THREAD_LOCAL_RENDERER_INSTANCE;
+    unique_ptr<Renderer> renderer = m_creator();
+    Renderer &ref = *renderer;
+    Registry &reg = registry();
+    lock_guard<mutex> guard(reg.m_mutex);
+    reg.m_threads[m_id].insert(&thread);
+    lock_guard<mutex> threadGuard(thread.m_mutex);
+    thread.m_renderers.emplace(m_id, move(renderer));
+    return ref;
   }
 
 private:
   Creator m_creator;
+  /** Never reused, unlike the address of an instance */
+  const uint64_t m_id;
 };
 
 ThreadLocalRenderer::ThreadLocalRenderer(Creator creator)
@@ -61,6 +144,11 @@ void ThreadLocalRenderer::render(const string &view, const Object &parameters,
 
 void ThreadLocalRenderer::render(const string &view, const string &parameters,
                                  Stream &stream) {
+  m_impl->render(view, string_view(parameters), stream);
+}
+
+void ThreadLocalRenderer::render(const string &view, string_view parameters,
+                                 Stream &stream) {
   m_impl->render(view, parameters, stream);
 }
 
@@ -46,7 +46,7 @@ Value::Value(Array d) : m_data(move(d)) {}
 
 Value::Value(const Object &d) : m_data(d) {}
 
-Value::Value(Object &&d) noexcept : m_data(d) {}
+Value::Value(Object &&d) noexcept : m_data(move(d)) {}
 
 Value::Value(Function d) : m_data(move(d)) {}
 
@@ -54,6 +54,8 @@ Value::Value(Proxy proxy) : m_data(move(proxy)) {}
 
 Value::Value(ProxyWeak proxyWeak) : m_data(move(proxyWeak)) {}
 
+Value::Value(SharedValue shared) : m_data(move(shared)) {}
+
 Value::Value(const char *s) {
   if (s) {
     m_data = String(s);
@@ -63,21 +65,29 @@ Value::Value(const char *s) {
 }
 
 bool Value::operator==(const Value &other) const {
-  return m_data == other.m_data;
+  return data() == other.data();
 }
 
 bool Value::operator!=(const Value &other) const {
-  return m_data != other.m_data;
+  return data() != other.data();
+}
+
+const Type &Value::data() const {
+  const Type *d = &m_data;
+  while (std::holds_alternative<SharedValue>(*d)) {
+    d = &std::get<SharedValue>(*d).value().m_data;
+  }
+  return *d;
 }
 
 template <>
 bool Value::is<Undefined>() const {
-  return holds<Undefined>();
+  return std::holds_alternative<Undefined>(data());
 }
 
 template <>
 bool Value::is<Null>() const {
-  return holds<Null>();
+  return std::holds_alternative<Null>(data());
 }
 
 template <>
@@ -222,8 +232,8 @@ ProxyWeak Value::get<ProxyWeak>() const {
 
 template <>
 optional<Bool> Value::optional() const {
-  if (holds<Bool>()) {
-    return std::get<Bool>(m_data);
+  if (std::holds_alternative<Bool>(data())) {
+    return std::get<Bool>(data());
   }
 
   return nullopt;
@@ -231,8 +241,8 @@ optional<Bool> Value::optional() const {
 
 template <>
 optional<int32_t> Value::optional() const {
-  if (holds<Number>()) {
-    return std::get<Number>(m_data).optional<int32_t>();
+  if (std::holds_alternative<Number>(data())) {
+    return std::get<Number>(data()).optional<int32_t>();
   }
 
   return nullopt;
@@ -240,8 +250,8 @@ optional<int32_t> Value::optional() const {
 
 template <>
 optional<uint32_t> Value::optional() const {
-  if (holds<Number>()) {
-    return std::get<Number>(m_data).optional<uint32_t>();
+  if (std::holds_alternative<Number>(data())) {
+    return std::get<Number>(data()).optional<uint32_t>();
   }
 
   return nullopt;
@@ -249,8 +259,8 @@ optional<uint32_t> Value::optional() const {
 
 template <>
 optional<int64_t> Value::optional() const {
-  if (holds<Number>()) {
-    return std::get<Number>(m_data).optional<int64_t>();
+  if (std::holds_alternative<Number>(data())) {
+    return std::get<Number>(data()).optional<int64_t>();
   }
 
   return nullopt;
@@ -258,8 +268,8 @@ optional<int64_t> Value::optional() const {
 
 template <>
 optional<double> Value::optional() const {
-  if (holds<Number>()) {
-    return std::get<Number>(m_data).optional<double>();
+  if (std::holds_alternative<Number>(data())) {
+    return std::get<Number>(data()).optional<double>();
   }
 
   return nullopt;
@@ -267,8 +277,8 @@ optional<double> Value::optional() const {
 
 template <>
 optional<Number> Value::optional() const {
-  if (holds<Number>()) {
-    return std::get<Number>(m_data);
+  if (std::holds_alternative<Number>(data())) {
+    return std::get<Number>(data());
   }
 
   return nullopt;
@@ -276,8 +286,8 @@ optional<Number> Value::optional() const {
 
 template <>
 optional<string> Value::optional() const {
-  if (holds<String>()) {
-    return std::get<String>(m_data).get<string>();
+  if (std::holds_alternative<String>(data())) {
+    return std::get<String>(data()).get<string>();
   } else {
     return nullopt;
   }
@@ -285,8 +295,8 @@ optional<string> Value::optional() const {
 
 template <>
 optional<string_view> Value::optional() const {
-  if (holds<String>()) {
-    return std::get<String>(m_data).get<string_view>();
+  if (std::holds_alternative<String>(data())) {
+    return std::get<String>(data()).get<string_view>();
   } else {
     return nullopt;
   }
@@ -294,8 +304,8 @@ optional<string_view> Value::optional() const {
 
 template <>
 optional<String> Value::optional() const {
-  if (holds<String>()) {
-    return std::get<String>(m_data);
+  if (std::holds_alternative<String>(data())) {
+    return std::get<String>(data());
   } else {
     return nullopt;
   }
@@ -303,8 +313,8 @@ optional<String> Value::optional() const {
 
 template <>
 optional<Array> Value::optional() const {
-  if (holds<Array>()) {
-    return std::get<Array>(m_data);
+  if (std::holds_alternative<Array>(data())) {
+    return std::get<Array>(data());
   }
 
   return nullopt;
@@ -312,8 +322,8 @@ optional<Array> Value::optional() const {
 
 template <>
 optional<Object> Value::optional() const {
-  if (holds<Object>()) {
-    return std::get<Object>(m_data);
+  if (std::holds_alternative<Object>(data())) {
+    return std::get<Object>(data());
   }
 
   return nullopt;
@@ -321,8 +331,8 @@ optional<Object> Value::optional() const {
 
 template <>
 optional<Function> Value::optional() const {
-  if (holds<Function>()) {
-    return std::get<Function>(m_data);
+  if (std::holds_alternative<Function>(data())) {
+    return std::get<Function>(data());
   }
 
   return nullopt;
@@ -330,8 +340,8 @@ optional<Function> Value::optional() const {
 
 template <>
 optional<Proxy> Value::optional() const {
-  if (holds<Proxy>()) {
-    return std::get<Proxy>(m_data);
+  if (std::holds_alternative<Proxy>(data())) {
+    return std::get<Proxy>(data());
   }
 
   return nullopt;
@@ -339,8 +349,8 @@ optional<Proxy> Value::optional() const {
 
 template <>
 optional<ProxyWeak> Value::optional() const {
-  if (holds<ProxyWeak>()) {
-    return std::get<ProxyWeak>(m_data);
+  if (std::holds_alternative<ProxyWeak>(data())) {
+    return std::get<ProxyWeak>(data());
   }
 
   return nullopt;
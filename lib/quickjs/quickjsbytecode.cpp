@@ -0,0 +1,41 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/quickjs/quickjsbytecode.h>
+
+#include "quickjshelper.h"
+
+using namespace complate;
+using namespace std;
+
+QuickJsBytecode::QuickJsBytecode(vector<uint8_t> data)
+    : m_data(move(data)) {}
+
+QuickJsBytecode QuickJsBytecode::compile(const string &source) {
+  JSRuntime *runtime = JS_NewRuntime();
+  JSContext *context = JS_NewContext(runtime);
+  try {
+    vector<uint8_t> data = QuickJsHelper::compile(context, source);
+    JS_FreeContext(context);
+    JS_FreeRuntime(runtime);
+    return QuickJsBytecode(move(data));
+  } catch (...) {
+    JS_FreeContext(context);
+    JS_FreeRuntime(runtime);
+    throw;
+  }
+}
+
+const vector<uint8_t> &QuickJsBytecode::data() const { return m_data; }
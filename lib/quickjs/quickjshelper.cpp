@@ -25,23 +25,57 @@ void QuickJsHelper::evaluate(JSContext *context, const string &source) {
                        JS_EVAL_TYPE_GLOBAL);
   if (JS_IsException(rc)) {
     JS_FreeValue(context, rc);
-    JSValue exc = JS_GetException(context);
-    const char *str = JS_ToCString(context, exc);
-    JS_FreeValue(context, exc);
-    throw Exception(str);
+    throwException(context);
   }
   JS_FreeValue(context, rc);
 }
 
+void QuickJsHelper::evaluate(JSContext *context,
+                             const vector<uint8_t> &bytecode) {
+  JSValue func = JS_ReadObject(context, bytecode.data(), bytecode.size(),
+                               JS_READ_OBJ_BYTECODE);
+  if (JS_IsException(func)) {
+    JS_FreeValue(context, func);
+    throwException(context);
+  }
+
+  /* JS_EvalFunction takes ownership of func */
+  JSValue rc = JS_EvalFunction(context, func);
+  if (JS_IsException(rc)) {
+    JS_FreeValue(context, rc);
+    throwException(context);
+  }
+  JS_FreeValue(context, rc);
+}
+
+vector<uint8_t> QuickJsHelper::compile(JSContext *context,
+                                       const string &source) {
+  JSValue func =
+      JS_Eval(context, source.c_str(), source.size(), "<source>",
+              JS_EVAL_TYPE_GLOBAL | JS_EVAL_FLAG_COMPILE_ONLY);
+  if (JS_IsException(func)) {
+    JS_FreeValue(context, func);
+    throwException(context);
+  }
+
+  size_t len = 0;
+  uint8_t *buf = JS_WriteObject(context, &len, func, JS_WRITE_OBJ_BYTECODE);
+  JS_FreeValue(context, func);
+  if (!buf) {
+    throwException(context);
+  }
+
+  vector<uint8_t> bytecode(buf, buf + len);
+  js_free(context, buf);
+  return bytecode;
+}
+
 JSValue QuickJsHelper::getFunction(JSContext *context, const string &name) {
   JSValue func = JS_Eval(context, name.c_str(), name.size(), "<func>",
                          JS_EVAL_TYPE_GLOBAL);
   if (JS_IsException(func)) {
     JS_FreeValue(context, func);
-    JSValue exc = JS_GetException(context);
-    const char *str = JS_ToCString(context, exc);
-    JS_FreeValue(context, exc);
-    throw Exception(str);
+    throwException(context);
   } else if (!JS_IsFunction(context, func)) {
     JS_FreeValue(context, func);
     throw Exception("Is not a function");
@@ -49,3 +83,12 @@ JSValue QuickJsHelper::getFunction(JSContext *context, const string &name) {
 
   return func;
 }
+
+void QuickJsHelper::throwException(JSContext *context) {
+  JSValue exc = JS_GetException(context);
+  const char *str = JS_ToCString(context, exc);
+  JS_FreeValue(context, exc);
+  string what = (str) ? str : "unknown exception";
+  JS_FreeCString(context, str);
+  throw Exception(what.c_str());
+}
@@ -25,5 +25,14 @@ class QuickJsHelper {
 public:
   static void evaluate(JSContext *context, const std::string &source);
 
+  static void evaluate(JSContext *context,
+                       const std::vector<uint8_t> &bytecode);
+
+  static std::vector<uint8_t> compile(JSContext *context,
+                                      const std::string &source);
+
   static JSValue getFunction(JSContext *context, const std::string &name);
+
+private:
+  [[noreturn]] static void throwException(JSContext *context);
 };
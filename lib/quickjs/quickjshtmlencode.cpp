@@ -0,0 +1,74 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include "quickjshtmlencode.h"
+
+#include <complate/core/htmlencode.h>
+
+#include <string>
+
+using namespace complate;
+using namespace std;
+
+QuickJsHtmlEncode::QuickJsHtmlEncode(JSContext *context)
+    : m_context(context) {}
+
+void QuickJsHtmlEncode::setEnabled(JSValueConst global, bool enabled) {
+  if (enabled == m_installed) {
+    return;
+  }
+
+  JSAtom name = JS_NewAtom(m_context, "htmlEncode");
+  if (enabled) {
+    if (JS_GetOwnProperty(m_context, nullptr, global, name) == 0) {
+      JSValue fn = JS_NewCFunction(m_context, encode, "htmlEncode", 2);
+      JS_DefinePropertyValue(m_context, global, name, fn,
+                             JS_PROP_WRITABLE | JS_PROP_CONFIGURABLE);
+      m_installed = true;
+    }
+  } else {
+    JS_DeleteProperty(m_context, global, name, 0);
+    m_installed = false;
+  }
+  JS_FreeAtom(m_context, name);
+}
+
+JSValue QuickJsHtmlEncode::encode(JSContext *ctx, JSValueConst, int argc,
+                                  JSValueConst *argv) {
+  JSValue str = (argc > 0) ? JS_ToString(ctx, argv[0])
+                           : JS_NewAtomString(ctx, "undefined");
+  if (JS_IsException(str)) {
+    return str;
+  }
+  const bool attribute = argc > 1 && JS_ToBool(ctx, argv[1]) > 0;
+
+  /* Returns the buffer of the string itself, when it's ASCII only */
+  size_t len;
+  const char *data = JS_ToCStringLen(ctx, &len, str);
+  if (data == nullptr) {
+    JS_FreeValue(ctx, str);
+    return JS_EXCEPTION;
+  }
+
+  const string_view view(data, len);
+  if (HtmlEncode::find(view, attribute) == string_view::npos) {
+    JS_FreeCString(ctx, data);
+    return str;
+  }
+  const string encoded = HtmlEncode::encode(view, attribute);
+  JS_FreeCString(ctx, data);
+  JS_FreeValue(ctx, str);
+  return JS_NewStringLen(ctx, encoded.data(), encoded.size());
+}
@@ -0,0 +1,40 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include "quickjs.h"
+
+namespace complate {
+
+/** Installs a native `htmlEncode(str, attribute)` in the global object */
+class QuickJsHtmlEncode {
+public:
+  explicit QuickJsHtmlEncode(JSContext *context);
+
+  /**
+   * Define or delete the global `htmlEncode`. An `htmlEncode` which wasn't
+   * defined by this class is kept untouched.
+   */
+  void setEnabled(JSValueConst global, bool enabled);
+
+private:
+  JSContext *m_context;
+  bool m_installed = false;
+
+  static JSValue encode(JSContext *ctx, JSValueConst this_val, int argc,
+                        JSValueConst *argv);
+};
+}  // namespace complate
@@ -0,0 +1,192 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include "quickjslazyobject.h"
+
+#include <complate/core/exception.h>
+
+#include "quickjsrenderercontext.h"
+
+using namespace complate;
+using namespace std;
+
+JSClassID QuickJsLazyObject::ms_class_id = 0;
+
+JSClassExoticMethods QuickJsLazyObject::ms_exotic = [] {
+  JSClassExoticMethods exotic{};
+  exotic.get_own_property = getOwnProperty;
+  exotic.get_own_property_names = getOwnPropertyNames;
+  exotic.delete_property = deleteProperty;
+  exotic.get_property = getProperty;
+  exotic.set_property = setProperty;
+  return exotic;
+}();
+
+void QuickJsLazyObject::registerClass(JSContext *context) {
+  if (ms_class_id == 0) {
+    JS_NewClassID(&ms_class_id);
+  }
+
+  JSRuntime *runtime = JS_GetRuntime(context);
+  if (!JS_IsRegisteredClass(runtime, ms_class_id)) {
+    JSClassDef classDef{};
+    classDef.class_name = "Object";
+    classDef.finalizer = finalizer;
+    classDef.exotic = &ms_exotic;
+    int rc = JS_NewClass(runtime, ms_class_id, &classDef);
+    if (rc < 0) {
+      throw Exception("could not register JSClassDef 'LazyObject'");
+    }
+  }
+
+  /* Inherit from Object.prototype like ordinary objects do */
+  JSValue obj = JS_NewObject(context);
+  JS_SetClassProto(context, ms_class_id, JS_GetPrototype(context, obj));
+  JS_FreeValue(context, obj);
+}
+
+JSValue QuickJsLazyObject::newInstance(JSContext *context, const Object &object,
+                                       weak_ptr<const void> scope) {
+  JSValue obj = JS_NewObjectClass(context, (int)ms_class_id);
+  JS_SetOpaque(obj, new State{&object, move(scope), {}});
+  return obj;
+}
+
+QuickJsLazyObject::State *QuickJsLazyObject::state(JSValueConst obj) {
+  return static_cast<State *>(JS_GetOpaque(obj, ms_class_id));
+}
+
+const Value *QuickJsLazyObject::find(JSContext *ctx, JSValueConst obj,
+                                     JSAtom prop, string &key) {
+  State *s = state(obj);
+  if (s == nullptr || s->m_scope.expired()) {
+    return nullptr;
+  }
+
+  JSValue name = JS_AtomToValue(ctx, prop);
+  if (!JS_IsString(name)) {
+    JS_FreeValue(ctx, name);
+    return nullptr;
+  }
+  size_t len;
+  const char *str = JS_ToCStringLen(ctx, &len, name);
+  JS_FreeValue(ctx, name);
+  if (str == nullptr) {
+    return nullptr;
+  }
+  key.assign(str, len);
+  JS_FreeCString(ctx, str);
+
+  auto it = s->m_object->find(key);
+  if (it == s->m_object->cend() || s->m_shadowed.count(key) != 0) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
+void QuickJsLazyObject::finalizer(JSRuntime *, JSValue val) {
+  delete state(val);
+}
+
+int QuickJsLazyObject::getOwnProperty(JSContext *ctx,
+                                      JSPropertyDescriptor *desc,
+                                      JSValueConst obj, JSAtom prop) {
+  string key;
+  const Value *value = find(ctx, obj, prop, key);
+  if (value == nullptr) {
+    return 0;
+  }
+
+  /* Must not define the property here, because QuickJS calls this while
+   * enumerating the properties. So the value isn't cached. */
+  if (desc != nullptr) {
+    auto rctx = QuickJsRendererContext::get(ctx);
+    desc->flags = JS_PROP_C_W_E;
+    desc->value = rctx->mapper().fromValueLazy(*value);
+    desc->getter = JS_UNDEFINED;
+    desc->setter = JS_UNDEFINED;
+  }
+  return 1;
+}
+
+int QuickJsLazyObject::getOwnPropertyNames(JSContext *ctx,
+                                           JSPropertyEnum **ptab,
+                                           uint32_t *plen, JSValueConst obj) {
+  *ptab = nullptr;
+  *plen = 0;
+  State *s = state(obj);
+  if (s == nullptr || s->m_scope.expired()) {
+    return 0;
+  }
+
+  const size_t size = s->m_object->size();
+  auto *tab = static_cast<JSPropertyEnum *>(
+      js_malloc(ctx, sizeof(JSPropertyEnum) * max<size_t>(size, 1)));
+  if (tab == nullptr) {
+    return -1;
+  }
+  uint32_t len = 0;
+  for (const auto &[k, v] : *s->m_object) {
+    if (s->m_shadowed.count(k) == 0) {
+      tab[len].is_enumerable = 1;
+      tab[len].atom = JS_NewAtomLen(ctx, k.data(), k.size());
+      ++len;
+    }
+  }
+  *ptab = tab;
+  *plen = len;
+  return 0;
+}
+
+int QuickJsLazyObject::deleteProperty(JSContext *ctx, JSValueConst obj,
+                                      JSAtom prop) {
+  string key;
+  if (find(ctx, obj, prop, key) != nullptr) {
+    state(obj)->m_shadowed.insert(key);
+  }
+  return 1;
+}
+
+JSValue QuickJsLazyObject::getProperty(JSContext *ctx, JSValueConst obj,
+                                       JSAtom prop, JSValueConst receiver) {
+  string key;
+  const Value *value = find(ctx, obj, prop, key);
+  if (value == nullptr) {
+    JSValue proto = JS_GetPrototype(ctx, obj);
+    JSValue result = JS_IsObject(proto)
+                         ? JS_GetPropertyInternal(ctx, proto, prop, receiver, 0)
+                         : JS_UNDEFINED;
+    JS_FreeValue(ctx, proto);
+    return result;
+  }
+
+  auto rctx = QuickJsRendererContext::get(ctx);
+  JSValue result = rctx->mapper().fromValueLazy(*value);
+  state(obj)->m_shadowed.insert(key);
+  JS_DefinePropertyValue(ctx, obj, prop, JS_DupValue(ctx, result),
+                         JS_PROP_C_W_E);
+  return result;
+}
+
+int QuickJsLazyObject::setProperty(JSContext *ctx, JSValueConst obj,
+                                   JSAtom prop, JSValueConst value,
+                                   JSValueConst receiver, int flags) {
+  string key;
+  if (find(ctx, obj, prop, key) != nullptr) {
+    state(obj)->m_shadowed.insert(key);
+  }
+  return JS_DefinePropertyValue(ctx, receiver, prop, JS_DupValue(ctx, value),
+                                JS_PROP_C_W_E | (flags & JS_PROP_THROW));
+}
@@ -0,0 +1,68 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <complate/core/value.h>
+
+#include <memory>
+#include <set>
+#include <string>
+
+#include "quickjs.h"
+
+namespace complate {
+
+/**
+ * Exotic JS object which maps the fields of an Object on first access.
+ *
+ * A mapped field is defined as ordinary property on the JS object, so every
+ * further access is served by QuickJS directly. The referenced Object must
+ * outlive the scope, after it expired the JS object appears to be empty.
+ */
+class QuickJsLazyObject {
+public:
+  static void registerClass(JSContext *context);
+
+  static JSValue newInstance(JSContext *context, const Object &object,
+                             std::weak_ptr<const void> scope);
+
+private:
+  struct State {
+    const Object *m_object;
+    std::weak_ptr<const void> m_scope;
+    /** Keys defined as ordinary property or deleted meanwhile */
+    std::set<std::string, std::less<>> m_shadowed;
+  };
+
+  static JSClassID ms_class_id;
+  static JSClassExoticMethods ms_exotic;
+
+  static State *state(JSValueConst obj);
+  static const Value *find(JSContext *ctx, JSValueConst obj, JSAtom prop,
+                           std::string &key);
+
+  static void finalizer(JSRuntime *rt, JSValue val);
+  static int getOwnProperty(JSContext *ctx, JSPropertyDescriptor *desc,
+                            JSValueConst obj, JSAtom prop);
+  static int getOwnPropertyNames(JSContext *ctx, JSPropertyEnum **ptab,
+                                 uint32_t *plen, JSValueConst obj);
+  static int deleteProperty(JSContext *ctx, JSValueConst obj, JSAtom prop);
+  static JSValue getProperty(JSContext *ctx, JSValueConst obj, JSAtom prop,
+                             JSValueConst receiver);
+  static int setProperty(JSContext *ctx, JSValueConst obj, JSAtom prop,
+                         JSValueConst value, JSValueConst receiver, int flags);
+};
+}  // namespace complate
@@ -15,12 +15,15 @@
  */
 #include "quickjsmapper.h"
 
+#include "quickjslazyobject.h"
 #include "quickjsrenderercontext.h"
 
 using namespace complate;
 using namespace std;
 
-QuickJsMapper::QuickJsMapper(JSContext *context) : m_context(context) {}
+QuickJsMapper::QuickJsMapper(JSContext *context) : m_context(context) {
+  QuickJsLazyObject::registerClass(context);
+}
 
 // NOLINTNEXTLINE(misc-no-recursion)
 JSValue QuickJsMapper::fromObject(const Object &object) {
@@ -35,6 +38,12 @@ JSValue QuickJsMapper::fromObject(const Object &object, JSValue parent) {
   return parent;
 }
 
+JSValue QuickJsMapper::fromObjectLazy(const Object &object) {
+  auto rctx = QuickJsRendererContext::get(m_context);
+  return QuickJsLazyObject::newInstance(m_context, object,
+                                        rctx->proxyHolder().scope());
+}
+
 // NOLINTNEXTLINE(misc-no-recursion)
 JSValue QuickJsMapper::fromArray(const Array &array) {
   JSValue arr = JS_NewArray(m_context);
@@ -64,11 +73,67 @@ JSValue QuickJsMapper::fromValue(const Value &value) {
     return fromProxy(value.exactly<Proxy>());
   } else if (value.holds<ProxyWeak>()) {
     return fromProxyWeak(value.exactly<ProxyWeak>());
+  } else if (value.holds<SharedValue>()) {
+    return fromValue(value.exactly<SharedValue>().value());
   } else {
     return JS_UNDEFINED;
   }
 }
 
+JSValue QuickJsMapper::fromValueLazy(const Value &value) {
+  if (value.holds<SharedValue>()) {
+    return fromValueLazy(value.exactly<SharedValue>().value());
+  } else if (value.holds<Object>()) {
+    return fromObjectLazy(value.exactly<Object>());
+  } else if (value.holds<Array>()) {
+    const auto &array = value.exactly<Array>();
+    JSValue arr = JS_NewArray(m_context);
+    for (uint32_t i = 0; i < array.size(); ++i) {
+      JS_SetPropertyUint32(m_context, arr, i, fromValueLazy(array[i]));
+    }
+    return arr;
+  } else {
+    return fromValue(value);
+  }
+}
+
+JSValue QuickJsMapper::fromValueFrozen(const Value &value) {
+  JSValue global = JS_GetGlobalObject(m_context);
+  JSValue object = JS_GetPropertyStr(m_context, global, "Object");
+  JSValue freeze = JS_GetPropertyStr(m_context, object, "freeze");
+  JSValue result = fromValueFrozen(value, freeze);
+  JS_FreeValue(m_context, freeze);
+  JS_FreeValue(m_context, object);
+  JS_FreeValue(m_context, global);
+  return result;
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+JSValue QuickJsMapper::fromValueFrozen(const Value &value,
+                                       JSValueConst freeze) {
+  JSValue result;
+  if (value.holds<SharedValue>()) {
+    return fromValueFrozen(value.exactly<SharedValue>().value(), freeze);
+  } else if (value.holds<Object>()) {
+    result = JS_NewObject(m_context);
+    for (const auto &[k, v] : value.exactly<Object>()) {
+      JS_SetPropertyStr(m_context, result, k.c_str(),
+                        fromValueFrozen(v, freeze));
+    }
+  } else if (value.holds<Array>()) {
+    const auto &array = value.exactly<Array>();
+    result = JS_NewArray(m_context);
+    for (uint32_t i = 0; i < array.size(); ++i) {
+      JS_SetPropertyUint32(m_context, result, i,
+                           fromValueFrozen(array[i], freeze));
+    }
+  } else {
+    return fromValue(value);
+  }
+  JS_FreeValue(m_context, JS_Call(m_context, freeze, JS_UNDEFINED, 1, &result));
+  return result;
+}
+
 JSValue QuickJsMapper::fromFunction(const Function &func) {
   JSValue v = JS_NewObject(m_context);
   JS_SetOpaque(v, (void *)&func);
@@ -27,8 +27,11 @@ public:
 
   JSValue fromObject(const Object &object);
   JSValue fromObject(const Object &object, JSValue parent);
+  JSValue fromObjectLazy(const Object &object);
   JSValue fromArray(const Array &array);
   JSValue fromValue(const Value &value);
+  JSValue fromValueLazy(const Value &value);
+  JSValue fromValueFrozen(const Value &value);
   JSValue fromFunction(const Function &func);
   JSValue fromProxy(const Proxy &proxy);
   JSValue fromProxyWeak(const ProxyWeak &proxyWeak);
@@ -36,6 +39,8 @@ public:
 private:
   JSContext *m_context;
 
+  JSValue fromValueFrozen(const Value &value, JSValueConst freeze);
+
   inline JSValue valueFrom(Bool d);
   inline JSValue valueFrom(const Number &number);
   inline JSValue valueFrom(const String &text);
@@ -0,0 +1,142 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include "quickjsmemo.h"
+
+#include <complate/core/exception.h>
+
+#include <string>
+
+#include "quickjsstreamadapter.h"
+
+using namespace complate;
+using namespace std;
+
+JSClassID QuickJsMemo::ms_class_id = 0;
+
+QuickJsMemo::QuickJsMemo(JSContext *context) : m_context(context) {
+  registerClass(context);
+}
+
+void QuickJsMemo::install(JSValueConst global, shared_ptr<MemoCache> cache) {
+  m_cache = move(cache);
+  if (m_installed) {
+    return;
+  }
+  m_installed = true;
+
+  JSAtom name = JS_NewAtom(m_context, "memo");
+  const int defined = JS_GetOwnProperty(m_context, nullptr, global, name);
+  if (defined != 0) {
+    JS_FreeAtom(m_context, name);
+    return;
+  }
+
+  /* JS_Eval requires a zero terminated string */
+  const string script(MemoCache::script());
+  JSValue factory = JS_Eval(m_context, script.c_str(), script.size(),
+                            "<memo>", JS_EVAL_TYPE_GLOBAL);
+  JSValue native = JS_NewObjectClass(m_context, (int)ms_class_id);
+  JS_SetOpaque(native, this);
+  JSValue memo = JS_Call(m_context, factory, JS_UNDEFINED, 1, &native);
+  JS_FreeValue(m_context, native);
+  JS_FreeValue(m_context, factory);
+  if (JS_IsException(memo)) {
+    JS_FreeAtom(m_context, name);
+    throw Exception("could not evaluate 'memo'");
+  }
+
+  JS_DefinePropertyValue(m_context, global, name, memo,
+                         JS_PROP_WRITABLE | JS_PROP_CONFIGURABLE);
+  JS_FreeAtom(m_context, name);
+}
+
+void QuickJsMemo::registerClass(JSContext *context) {
+  if (ms_class_id == 0) {
+    JS_NewClassID(&ms_class_id);
+  }
+
+  JSRuntime *runtime = JS_GetRuntime(context);
+  if (!JS_IsRegisteredClass(runtime, ms_class_id)) {
+    JSClassDef classDef{};
+    classDef.class_name = "ComplateMemo";
+    int rc = JS_NewClass(runtime, ms_class_id, &classDef);
+    if (rc < 0) {
+      throw Exception("could not register JSClassDef 'ComplateMemo'");
+    }
+  }
+
+  JSValue proto = JS_NewObject(context);
+  JS_SetPropertyFunctionList(context, proto, MSCE_FUNCTIONS.data(),
+                             MSCE_FUNCTIONS.size());
+  JS_SetClassProto(context, ms_class_id, proto);
+}
+
+QuickJsMemo *QuickJsMemo::memoOf(JSContext *ctx, JSValueConst this_val) {
+  return static_cast<QuickJsMemo *>(JS_GetOpaque2(ctx, this_val, ms_class_id));
+}
+
+JSValue QuickJsMemo::replay(JSContext *ctx, JSValueConst this_val, int,
+                            JSValueConst *argv) {
+  QuickJsMemo *memo = memoOf(ctx, this_val);
+  if (memo == nullptr) {
+    return JS_EXCEPTION;
+  }
+
+  size_t len;
+  const char *key = JS_ToCStringLen(ctx, &len, argv[1]);
+  if (key == nullptr) {
+    return JS_EXCEPTION;
+  }
+  auto html = (memo->m_cache) ? memo->m_cache->get({key, len}) : nullptr;
+  JS_FreeCString(ctx, key);
+  if (!html) {
+    return JS_UNDEFINED;
+  }
+
+  Stream *stream = QuickJsStreamAdapter::streamOf(ctx, argv[0]);
+  if (stream != nullptr) {
+    stream->write(html->data(), (int)html->size());
+    return JS_TRUE;
+  }
+  return JS_NewStringLen(ctx, html->data(), html->size());
+}
+
+JSValue QuickJsMemo::store(JSContext *ctx, JSValueConst this_val, int,
+                           JSValueConst *argv) {
+  QuickJsMemo *memo = memoOf(ctx, this_val);
+  if (memo == nullptr) {
+    return JS_EXCEPTION;
+  }
+
+  size_t keyLen;
+  const char *key = JS_ToCStringLen(ctx, &keyLen, argv[0]);
+  if (key == nullptr) {
+    return JS_EXCEPTION;
+  }
+  size_t htmlLen;
+  const char *html = JS_ToCStringLen(ctx, &htmlLen, argv[1]);
+  if (html == nullptr) {
+    JS_FreeCString(ctx, key);
+    return JS_EXCEPTION;
+  }
+
+  if (memo->m_cache) {
+    memo->m_cache->put({key, keyLen}, string(html, htmlLen));
+  }
+  JS_FreeCString(ctx, html);
+  JS_FreeCString(ctx, key);
+  return JS_UNDEFINED;
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <complate/core/memocache.h>
+
+#include <array>
+#include <memory>
+
+#include "quickjs.h"
+#include "quickjsfunctionlistentry.h"
+
+namespace complate {
+
+/** Installs the `memo` binding backed by a MemoCache */
+class QuickJsMemo {
+public:
+  explicit QuickJsMemo(JSContext *context);
+
+  /**
+   * Use the cache for `memo`, which is defined in the global object on first
+   * call, unless it already has a `memo`. Without a cache `memo` always
+   * renders the component.
+   */
+  void install(JSValueConst global, std::shared_ptr<MemoCache> cache);
+
+private:
+  JSContext *m_context;
+  std::shared_ptr<MemoCache> m_cache;
+  bool m_installed = false;
+  static JSClassID ms_class_id;
+
+  static void registerClass(JSContext *context);
+
+  static QuickJsMemo *memoOf(JSContext *ctx, JSValueConst this_val);
+
+  static JSValue replay(JSContext *ctx, JSValueConst this_val, int argc,
+                        JSValueConst *argv);
+  static JSValue store(JSContext *ctx, JSValueConst this_val, int argc,
+                       JSValueConst *argv);
+
+  static constexpr std::array<JSCFunctionListEntry, 2> MSCE_FUNCTIONS{
+      QuickJsFunctionListEntry::cfunc("replay", 2, replay),
+      QuickJsFunctionListEntry::cfunc("store", 2, store)};
+};
+}  // namespace complate
@@ -0,0 +1,136 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include "quickjsnativecall.h"
+
+#include "quickjsrenderercontext.h"
+
+using namespace complate;
+using namespace std;
+
+QuickJsNativeCall::QuickJsNativeCall(JSContext *context, int argc,
+                                     JSValueConst *argv)
+    : m_context(context),
+      m_argc(argc),
+      m_argv(argv),
+      m_result(JS_UNDEFINED),
+      m_exception(false) {}
+
+QuickJsNativeCall::~QuickJsNativeCall() {
+  JS_FreeValue(m_context, m_result);
+}
+
+JSValue QuickJsNativeCall::result() {
+  JSValue result = m_exception ? JS_EXCEPTION : m_result;
+  if (m_exception) {
+    JS_FreeValue(m_context, m_result);
+  }
+  m_result = JS_UNDEFINED;
+  return result;
+}
+
+int QuickJsNativeCall::argc() const { return m_argc; }
+
+bool QuickJsNativeCall::failed() const { return m_exception; }
+
+bool QuickJsNativeCall::toBool(int index) {
+  int rc = JS_ToBool(m_context, arg(index));
+  check(rc);
+  return rc > 0;
+}
+
+int32_t QuickJsNativeCall::toInt32(int index) {
+  int32_t value = 0;
+  check(JS_ToInt32(m_context, &value, arg(index)));
+  return value;
+}
+
+int64_t QuickJsNativeCall::toInt64(int index) {
+  int64_t value = 0;
+  check(JS_ToInt64(m_context, &value, arg(index)));
+  return value;
+}
+
+double QuickJsNativeCall::toDouble(int index) {
+  double value = 0;
+  check(JS_ToFloat64(m_context, &value, arg(index)));
+  return value;
+}
+
+string QuickJsNativeCall::toString(int index) {
+  size_t len = 0;
+  const char *str = JS_ToCStringLen(m_context, &len, arg(index));
+  if (!str) {
+    check(-1);
+    return {};
+  }
+  string value(str, len);
+  JS_FreeCString(m_context, str);
+  return value;
+}
+
+Value QuickJsNativeCall::toValue(int index) {
+  auto rctx = QuickJsRendererContext::get(m_context);
+  return rctx->unmapper().fromValue(arg(index));
+}
+
+void QuickJsNativeCall::returnUndefined() { setResult(JS_UNDEFINED); }
+
+void QuickJsNativeCall::returnNull() { setResult(JS_NULL); }
+
+void QuickJsNativeCall::returnBool(bool value) {
+  setResult(JS_NewBool(m_context, value));
+}
+
+void QuickJsNativeCall::returnInt32(int32_t value) {
+  setResult(JS_NewInt32(m_context, value));
+}
+
+void QuickJsNativeCall::returnUint32(uint32_t value) {
+  setResult(JS_NewUint32(m_context, value));
+}
+
+void QuickJsNativeCall::returnInt64(int64_t value) {
+  setResult(JS_NewInt64(m_context, value));
+}
+
+void QuickJsNativeCall::returnDouble(double value) {
+  setResult(JS_NewFloat64(m_context, value));
+}
+
+void QuickJsNativeCall::returnString(string_view value) {
+  setResult(JS_NewStringLen(m_context, value.data(), value.size()));
+}
+
+void QuickJsNativeCall::returnValue(const Value &value) {
+  auto rctx = QuickJsRendererContext::get(m_context);
+  setResult(rctx->mapper().fromValue(value));
+}
+
+JSValueConst QuickJsNativeCall::arg(int index) const {
+  // once a conversion threw, the remaining arguments are not converted
+  return (!m_exception && index < m_argc) ? m_argv[index] : JS_UNDEFINED;
+}
+
+void QuickJsNativeCall::setResult(JSValue value) {
+  JS_FreeValue(m_context, m_result);
+  m_result = value;
+}
+
+void QuickJsNativeCall::check(int rc) {
+  if (rc < 0) {
+    m_exception = true;
+  }
+}
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <complate/core/nativecall.h>
+
+#include "quickjs.h"
+
+namespace complate {
+
+class QuickJsNativeCall : public NativeCall {
+public:
+  QuickJsNativeCall(JSContext *context, int argc, JSValueConst *argv);
+  ~QuickJsNativeCall() override;
+
+  QuickJsNativeCall(const QuickJsNativeCall &) = delete;
+  QuickJsNativeCall &operator=(const QuickJsNativeCall &) = delete;
+
+  /** Release the result, JS_EXCEPTION if an argument failed to convert. */
+  [[nodiscard]] JSValue result();
+
+  [[nodiscard]] int argc() const override;
+  [[nodiscard]] bool failed() const override;
+  [[nodiscard]] bool toBool(int index) override;
+  [[nodiscard]] int32_t toInt32(int index) override;
+  [[nodiscard]] int64_t toInt64(int index) override;
+  [[nodiscard]] double toDouble(int index) override;
+  [[nodiscard]] std::string toString(int index) override;
+  [[nodiscard]] Value toValue(int index) override;
+
+  void returnUndefined() override;
+  void returnNull() override;
+  void returnBool(bool value) override;
+  void returnInt32(int32_t value) override;
+  void returnUint32(uint32_t value) override;
+  void returnInt64(int64_t value) override;
+  void returnDouble(double value) override;
+  void returnString(std::string_view value) override;
+  void returnValue(const Value &value) override;
+
+private:
+  JSContext *m_context;
+  int m_argc;
+  JSValueConst *m_argv;
+  JSValue m_result;
+  bool m_exception;
+
+  [[nodiscard]] JSValueConst arg(int index) const;
+  void setResult(JSValue value);
+  void check(int rc);
+};
+}  // namespace complate
@@ -15,14 +15,60 @@
  */
 #include "quickjsprototyperegistry.h"
 
+#include <limits>
+
+#include "quickjsnativecall.h"
 #include "quickjsrenderercontext.h"
 
 using namespace std;
 using namespace complate;
 
+/**
+ * Borrows an argument Array of the registry for one method call.
+ *
+ * The Arrays keep their capacity, so calls do not allocate once warmed up.
+ * Nested calls (a method calling back into JavaScript) get their own Array.
+ */
+class QuickJsPrototypeRegistry::Arguments {
+public:
+  Arguments(QuickJsPrototypeRegistry &registry, int argc, JSValueConst *argv,
+            QuickJsUnmapper &unmapper)
+      : m_registry(registry) {
+    if (m_registry.m_depth == m_registry.m_arguments.size()) {
+      m_registry.m_arguments.emplace_back().reserve(4);
+    }
+    m_args = &m_registry.m_arguments[m_registry.m_depth++];
+    for (int i = 0; i < argc; ++i) {
+      m_args->emplace_back(unmapper.fromValue(argv[i]));
+    }
+  }
+
+  ~Arguments() {
+    m_args->clear();
+    m_registry.m_depth--;
+  }
+
+  Arguments(const Arguments &) = delete;
+  Arguments &operator=(const Arguments &) = delete;
+
+  [[nodiscard]] const Array &get() const { return *m_args; }
+
+private:
+  QuickJsPrototypeRegistry &m_registry;
+  Array *m_args;
+};
+
 QuickJsPrototypeRegistry::QuickJsPrototypeRegistry(JSContext *context)
     : m_context(context) {}
 
+QuickJsPrototypeRegistry::~QuickJsPrototypeRegistry() {
+  for (const auto &[name, entry] : m_entries) {
+    for (JSAtom atom : entry.m_atoms) {
+      JS_FreeAtom(m_context, atom);
+    }
+  }
+}
+
 void QuickJsPrototypeRegistry::add(const Prototype &prototype) {
   JSClassID classId = 0;
   JS_NewClassID(&classId);
@@ -39,24 +85,30 @@ void QuickJsPrototypeRegistry::add(const Prototype &prototype) {
   auto proto = make_unique<Prototype>(prototype);
 
   auto functions = make_unique<vector<JSCFunctionListEntry>>();
-  int16_t i = 1;
   for (const auto &method : proto->methods()) {
-    functions->push_back(entry(method.name(), i));
-    JS_SetPropertyUint32(m_context, tmpl, i, JS_MKPTR(1, (void *)&method));
-    i++;
+    functions->push_back(
+        entry(method.name(), addMember(classId, &method, nullptr)));
   }
 
   for (const auto &property : proto->properties()) {
-    functions->push_back(getset(property.name(), i));
-    JS_SetPropertyUint32(m_context, tmpl, i, JS_MKPTR(1, (void *)&property));
-    i++;
+    functions->push_back(
+        getset(property.name(), addMember(classId, nullptr, &property)));
   }
 
   JS_SetPropertyFunctionList(m_context, tmpl, functions->data(),
                              (int)functions->size());
   JS_SetClassProto(m_context, classId, tmpl);
-  m_entries.emplace(prototype.name(),
-                    Entry{classId, move(proto), move(functions)});
+
+  /* the getters of the class proto can be deleted by JavaScript, so the
+   * entry holds its own reference to each atom */
+  vector<JSAtom> atoms;
+  if (proto->snapshot()) {
+    for (const auto &property : proto->properties()) {
+      atoms.push_back(JS_NewAtom(m_context, property.name().c_str()));
+    }
+  }
+  m_entries.emplace(prototype.name(), Entry{classId, move(proto),
+                                            move(functions), move(atoms)});
 }
 
 JSValue QuickJsPrototypeRegistry::newInstanceOf(const Proxy &proxy) const {
@@ -72,28 +124,81 @@ JSValue QuickJsPrototypeRegistry::newInstanceOf(
 JSValue QuickJsPrototypeRegistry::newInstanceOf(const string &name,
                                                 void *ptr) const {
   auto it = m_entries.find(name);
-  if (it != m_entries.cend()) {
+  if (it != m_entries.cend() && it->second.m_prototype->snapshot()) {
+    return newSnapshotOf(it->second, ptr);
+  } else if (it != m_entries.cend()) {
     JSValue object = JS_NewObjectClass(m_context, (int)it->second.m_classId);
-    JS_SetPropertyUint32(m_context, object, 0, JS_MKPTR(1, ptr));
+    JS_SetOpaque(object, ptr);
     return object;
   } else {
     return JS_UNDEFINED;
   }
 }
 
+JSValue QuickJsPrototypeRegistry::newSnapshotOf(const Entry &entry,
+                                                void *ptr) const {
+  const auto &prototype = *entry.m_prototype;
+  JSValue object;
+  if (prototype.methods().empty()) {
+    object = JS_NewObject(m_context);
+  } else {
+    object = JS_NewObjectClass(m_context, (int)entry.m_classId);
+    JS_SetOpaque(object, ptr);
+  }
+
+  auto rctx = QuickJsRendererContext::get(m_context);
+  const auto &properties = prototype.properties();
+  for (size_t i = 0; i < properties.size(); ++i) {
+    JSValue value;
+    if (properties[i].typed()) {
+      QuickJsNativeCall call(m_context, 0, nullptr);
+      properties[i].invoke(ptr, call);
+      value = call.result();
+    } else {
+      value = rctx->mapper().fromValue(properties[i].get(ptr));
+    }
+    JS_DefinePropertyValue(m_context, object, entry.m_atoms[i], value,
+                           JS_PROP_C_W_E);
+  }
+  return object;
+}
+
+void QuickJsPrototypeRegistry::startCache() { m_caching = true; }
+
+void QuickJsPrototypeRegistry::clearCache() {
+  for (auto &[key, value] : m_cache) {
+    JS_FreeValue(m_context, value);
+  }
+  m_cache.clear();
+  m_caching = false;
+}
+
+int16_t QuickJsPrototypeRegistry::addMember(JSClassID classId,
+                                            const Method *method,
+                                            const Property *property) {
+  if (m_members.size() > (size_t)numeric_limits<int16_t>::max()) {
+    throw Exception("too many methods and properties in Prototype's");
+  }
+  m_members.push_back(Member{classId, method, property});
+  return (int16_t)(m_members.size() - 1);
+}
+
 JSValue QuickJsPrototypeRegistry::methodCall(JSContext *ctx, JSValue this_val,
                                              int argc, JSValue *argv,
                                              int magic) {
   auto rctx = QuickJsRendererContext::get(ctx);
-  Array args;
-  for (int i = 0; i < argc; ++i) {
-    args.emplace_back(rctx->unmapper().fromValue(argv[i]));
+  auto &registry = rctx->prototypeRegistry();
+  const auto &member = registry.m_members[magic];
+  void *proxy = JS_GetOpaque(this_val, member.m_classId);
+
+  if (member.m_method->typed()) {
+    QuickJsNativeCall call(ctx, argc, argv);
+    member.m_method->invoke(proxy, call);
+    return call.result();
   }
-  void *proxy = JS_VALUE_GET_PTR(JS_GetPropertyUint32(ctx, this_val, 0));
-  JSValue m = JS_GetPropertyUint32(ctx, this_val, magic);
-  auto method = static_cast<Method *>(JS_VALUE_GET_PTR(m));
 
-  return rctx->mapper().fromValue(method->apply(proxy, args));
+  Arguments args(registry, argc, argv, rctx->unmapper());
+  return rctx->mapper().fromValue(member.m_method->apply(proxy, args.get()));
 }
 
 JSCFunctionListEntry QuickJsPrototypeRegistry::entry(const string &name,
@@ -124,22 +229,46 @@ JSCFunctionListEntry QuickJsPrototypeRegistry::getset(const string &name,
 JSValue QuickJsPrototypeRegistry::getter(JSContext *ctx, JSValue this_val,
                                          int magic) {
   auto rctx = QuickJsRendererContext::get(ctx);
+  auto &registry = rctx->prototypeRegistry();
+  const auto &member = registry.m_members[magic];
+  void *proxy = JS_GetOpaque(this_val, member.m_classId);
 
-  void *proxy = JS_VALUE_GET_PTR(JS_GetPropertyUint32(ctx, this_val, 0));
-  JSValue m = JS_GetPropertyUint32(ctx, this_val, magic);
-  auto property = static_cast<Property *>(JS_VALUE_GET_PTR(m));
+  const bool cached = registry.m_caching && proxy && member.m_property->pure();
+  if (cached) {
+    auto it = registry.m_cache.find({proxy, magic});
+    if (it != registry.m_cache.end()) {
+      return JS_DupValue(ctx, it->second);
+    }
+  }
 
-  return rctx->mapper().fromValue(property->get(proxy));
+  JSValue value;
+  if (member.m_property->typed()) {
+    QuickJsNativeCall call(ctx, 0, nullptr);
+    member.m_property->invoke(proxy, call);
+    value = call.result();
+  } else {
+    value = rctx->mapper().fromValue(member.m_property->get(proxy));
+  }
+
+  if (cached && !JS_IsException(value)) {
+    registry.m_cache.emplace(CacheKey{proxy, magic}, JS_DupValue(ctx, value));
+  }
+  return value;
 }
 
 JSValue QuickJsPrototypeRegistry::setter(JSContext *ctx, JSValue this_val,
                                          JSValue val, int magic) {
   auto rctx = QuickJsRendererContext::get(ctx);
+  auto &registry = rctx->prototypeRegistry();
+  const auto &member = registry.m_members[magic];
+  void *proxy = JS_GetOpaque(this_val, member.m_classId);
 
-  void *proxy = JS_VALUE_GET_PTR(JS_GetPropertyUint32(ctx, this_val, 0));
-  JSValue m = JS_GetPropertyUint32(ctx, this_val, magic);
-  auto property = static_cast<Property *>(JS_VALUE_GET_PTR(m));
+  member.m_property->set(proxy, rctx->unmapper().fromValue(val));
 
-  property->set(proxy, rctx->unmapper().fromValue(val));
+  auto it = registry.m_cache.find({proxy, magic});
+  if (it != registry.m_cache.end()) {
+    JS_FreeValue(ctx, it->second);
+    registry.m_cache.erase(it);
+  }
   return JS_UNDEFINED;
 }
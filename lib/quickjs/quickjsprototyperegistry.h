@@ -17,28 +17,67 @@
 #include <complate/core/prototype.h>
 #include <quickjs.h>
 
+#include <deque>
 #include <map>
+#include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
-#include <memory>
 
 namespace complate {
 
 class QuickJsPrototypeRegistry {
 public:
   explicit QuickJsPrototypeRegistry(JSContext *context);
+  /** Frees the atoms of the Prototype's, so the context must still live */
+  ~QuickJsPrototypeRegistry();
+
+  QuickJsPrototypeRegistry(const QuickJsPrototypeRegistry &) = delete;
+  QuickJsPrototypeRegistry &operator=(const QuickJsPrototypeRegistry &) =
+      delete;
 
   void add(const Prototype &prototype);
 
   [[nodiscard]] JSValue newInstanceOf(const Proxy &proxy) const;
   [[nodiscard]] JSValue newInstanceOf(const ProxyWeak &proxyWeak) const;
 
+  /** Memoize the values of pure Property's until clearCache() */
+  void startCache();
+  /** Free the memoized values and stop memoizing */
+  void clearCache();
+
 private:
   struct Entry;
+  struct Member;
+  class Arguments;
   JSContext *m_context;
   std::map<std::string, Entry> m_entries;
+  /** Methods and properties of all prototypes, indexed by magic */
+  std::vector<Member> m_members;
+  /** Reused argument Arrays, one per nested method call */
+  std::deque<Array> m_arguments;
+  size_t m_depth = 0;
+  /** Values of pure Property's by object and magic */
+  struct CacheKey {
+    const void *m_object;
+    int m_magic;
+    bool operator==(const CacheKey &other) const {
+      return m_object == other.m_object && m_magic == other.m_magic;
+    }
+  };
+  struct CacheKeyHash {
+    size_t operator()(const CacheKey &key) const {
+      return std::hash<const void *>()(key.m_object) * 31 + key.m_magic;
+    }
+  };
+  std::unordered_map<CacheKey, JSValue, CacheKeyHash> m_cache;
+  bool m_caching = false;
+
+  int16_t addMember(JSClassID classId, const Method *method,
+                    const Property *property);
 
   [[nodiscard]] JSValue newInstanceOf(const std::string &name, void *ptr) const;
+  [[nodiscard]] JSValue newSnapshotOf(const Entry &entry, void *ptr) const;
 
   static JSValue methodCall(JSContext *ctx, JSValueConst this_val, int argc,
                             JSValueConst *argv, int magic);
@@ -50,10 +89,18 @@ private:
   static JSValue setter(JSContext *ctx, JSValueConst this_val, JSValueConst val,
                         int magic);
 
+  struct Member {
+    JSClassID m_classId;
+    const Method *m_method;
+    const Property *m_property;
+  };
+
   struct Entry {
     JSClassID m_classId;
     std::unique_ptr<Prototype> m_prototype;
     std::unique_ptr<std::vector<JSCFunctionListEntry>> m_function;
+    /** Property names of a snapshot Prototype, freed by the registry */
+    std::vector<JSAtom> m_atoms;
   };
 };
 }  // namespace complate
@@ -18,8 +18,17 @@
 using namespace complate;
 
 QuickJsProxyDeleter::QuickJsProxyDeleter(QuickJsProxyHolder& holder)
-    : m_holder(holder) {}
+    : m_holder(holder), m_registry(nullptr) {}
+
+QuickJsProxyDeleter::QuickJsProxyDeleter(QuickJsProxyHolder& holder,
+                                         QuickJsPrototypeRegistry& registry)
+    : m_holder(holder), m_registry(&registry) {
+  m_registry->startCache();
+}
 
 QuickJsProxyDeleter::~QuickJsProxyDeleter() {
+  if (m_registry) {
+    m_registry->clearCache();
+  }
   m_holder.clear();
 }
@@ -15,6 +15,7 @@
 */
 #pragma once
 
+#include "quickjsprototyperegistry.h"
 #include "quickjsproxyholder.h"
 
 namespace complate {
@@ -22,10 +23,14 @@ namespace complate {
 class QuickJsProxyDeleter {
 public:
   explicit QuickJsProxyDeleter(QuickJsProxyHolder &holder);
+  /** Also memoize pure Property values of the registry until destruction */
+  QuickJsProxyDeleter(QuickJsProxyHolder &holder,
+                      QuickJsPrototypeRegistry &registry);
   ~QuickJsProxyDeleter();
 
 private:
   QuickJsProxyHolder &m_holder;
+  QuickJsPrototypeRegistry *m_registry;
 };
 }
 
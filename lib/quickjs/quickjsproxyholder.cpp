@@ -16,6 +16,9 @@
 #include "quickjsproxyholder.h"
 
 using namespace complate;
+using namespace std;
+
+QuickJsProxyHolder::QuickJsProxyHolder() : m_scope(make_shared<char>()) {}
 
 void QuickJsProxyHolder::add(const Proxy& proxy) {
   m_proxies.push_back(proxy);
@@ -23,4 +26,7 @@ void QuickJsProxyHolder::add(const Proxy& proxy) {
 
 void QuickJsProxyHolder::clear() {
   m_proxies.clear();
+  m_scope = make_shared<char>();
 }
+
+weak_ptr<const void> QuickJsProxyHolder::scope() const { return m_scope; }
@@ -17,17 +17,24 @@
 
 #include <complate/core/proxy.h>
 
+#include <memory>
 #include <vector>
 
 namespace complate {
 
 class QuickJsProxyHolder {
 public:
+  QuickJsProxyHolder();
+
   void add(const Proxy &proxy);
   void clear();
 
+  /** Token which expires upon clear() */
+  [[nodiscard]] std::weak_ptr<const void> scope() const;
+
 private:
   std::vector<Proxy> m_proxies;
+  std::shared_ptr<const void> m_scope;
 };
 
 }  // namespace complate
@@ -14,13 +14,18 @@
  *  limitations under the License.
  */
 #include <complate/core/exception.h>
+#include <complate/core/stringstream.h>
 #include <complate/quickjs/quickjsrenderer.h>
 
+#include <algorithm>
+#include <map>
 #include <mutex>
 #include <utility>
 
 #include "quickjsconsole.h"
 #include "quickjshelper.h"
+#include "quickjshtmlencode.h"
+#include "quickjsmemo.h"
 #include "quickjsrenderercontext.h"
 #include "quickjsstreamadapter.h"
 #include "quickjsproxydeleter.h"
@@ -30,24 +35,35 @@ using namespace std;
 
 class QuickJsRenderer::Impl {
 public:
-  explicit Impl(const string &source, const std::vector<Prototype> &prototypes,
-                Object bindings)
+  template <typename Source>
+  Impl(const Source &source, const std::vector<Prototype> &prototypes,
+       Object bindings)
       : m_runtime(JS_NewRuntime()),
         m_context(JS_NewContext(m_runtime)),
-        m_rendererContext(m_context, prototypes),
+        m_rendererContext(
+            make_unique<QuickJsRendererContext>(m_context, prototypes)),
         m_global(JS_GetGlobalObject(m_context)),
         m_render(evaluateSource(m_context, source)),
         m_streamAdapter(m_context),
+        m_memo(m_context),
+        m_htmlEncode(m_context),
         m_bindings(move(bindings)) {
-    QuickJsProxyDeleter deleter(m_rendererContext.proxyHolder());
+    QuickJsProxyDeleter deleter(m_rendererContext->proxyHolder());
     JS_SetMaxStackSize(m_runtime, NO_STACK_LIMIT);
     ensureConsoleDefined(m_bindings);
-    m_rendererContext.mapper().fromObject(m_bindings, m_global);
+    m_rendererContext->mapper().fromObject(m_bindings, m_global);
   }
 
   ~Impl() {
+    for (auto &[name, shared] : m_sharedParameters) {
+      freeSharedParameter(shared);
+    }
+    for (auto &parsed : m_parsed) {
+      JS_FreeValue(m_context, parsed.m_value);
+    }
     JS_FreeValue(m_context, m_render);
     JS_FreeValue(m_context, m_global);
+    m_rendererContext.reset();
     JS_FreeContext(m_context);
     JS_FreeRuntime(m_runtime);
   }
@@ -55,21 +71,74 @@ public:
   void render(const string &view, const Object &parameters, Stream &stream) {
     lock_guard<mutex> guard(m_mutex);
     JS_UpdateStackTop(m_runtime);
-    QuickJsProxyDeleter deleter(m_rendererContext.proxyHolder());
-    render(view, m_rendererContext.mapper().fromObject(parameters), stream);
+    QuickJsProxyDeleter deleter(m_rendererContext->proxyHolder(),
+                                m_rendererContext->prototypeRegistry());
+    auto &mapper = m_rendererContext->mapper();
+    render(view,
+           (m_lazyMapping) ? mapper.fromObjectLazy(parameters)
+                           : mapper.fromObject(parameters),
+           stream);
   }
 
-  void render(const string &view, const string &parameters, Stream &stream) {
+  void render(const string &view, string_view parameters, Stream &stream) {
     lock_guard<mutex> guard(m_mutex);
     JS_UpdateStackTop(m_runtime);
-    JSValue json = JS_ParseJSON(m_context, parameters.c_str(),
-                                parameters.size(), "<json>");
-    if (!JS_IsObject(json)) {
-      JS_FreeValue(m_context, json);
-      throw Exception("SyntaxError: 'parameters' is not an object");
+    render(view, parseJson(parameters), stream);
+  }
+
+  ParsedParameters parse(string_view parameters) {
+    lock_guard<mutex> guard(m_mutex);
+    JS_UpdateStackTop(m_runtime);
+    releaseParsed();
+    JSValue json = parseJson(parameters);
+    auto handle = make_shared<const JSValue>(json);
+    m_parsed.push_back({handle, json});
+    return ParsedParameters(this, move(handle));
+  }
+
+  void render(const string &view, const ParsedParameters &parameters,
+              Stream &stream) {
+    if (!parameters || parameters.owner() != this) {
+      throw Exception("'parameters' were not parsed by this renderer");
     }
+    lock_guard<mutex> guard(m_mutex);
+    JS_UpdateStackTop(m_runtime);
+    const auto *json = static_cast<const JSValue *>(parameters.parsed());
+    render(view, copyOf(*json), stream);
+  }
+
+  void setLazyMapping(bool enabled) {
+    lock_guard<mutex> guard(m_mutex);
+    m_lazyMapping = enabled;
+  }
+
+  void setSharedParameter(const string &name, Value value) {
+    lock_guard<mutex> guard(m_mutex);
+    JS_UpdateStackTop(m_runtime);
+    removeSharedParameter(name, guard);
+    JSAtom atom = JS_NewAtomLen(m_context, name.data(), name.size());
+    auto &shared = m_sharedParameters[name];
+    shared = SharedParameter{move(value), atom, JS_UNDEFINED};
+    QuickJsProxyDeleter deleter(m_rendererContext->proxyHolder());
+    auto &mapper = m_rendererContext->mapper();
+    shared.m_mapped = mapper.fromValueFrozen(shared.m_value);
+  }
 
-    render(view, json, stream);
+  void removeSharedParameter(const string &name) {
+    lock_guard<mutex> guard(m_mutex);
+    removeSharedParameter(name, guard);
+  }
+
+  void setMemoCache(shared_ptr<MemoCache> cache) {
+    lock_guard<mutex> guard(m_mutex);
+    JS_UpdateStackTop(m_runtime);
+    m_memo.install(m_global, move(cache));
+  }
+
+  void setHtmlEncode(bool enabled) {
+    lock_guard<mutex> guard(m_mutex);
+    JS_UpdateStackTop(m_runtime);
+    m_htmlEncode.setEnabled(m_global, enabled);
   }
 
 private:
@@ -77,13 +146,107 @@ private:
   mutex m_mutex;
   JSRuntime *m_runtime;
   JSContext *m_context;
-  QuickJsRendererContext m_rendererContext;
+  /** Reset before the context is freed, see ~Impl() */
+  unique_ptr<QuickJsRendererContext> m_rendererContext;
   JSValue m_global;
   JSValue m_render;
   QuickJsStreamAdapter m_streamAdapter;
+  QuickJsMemo m_memo;
+  QuickJsHtmlEncode m_htmlEncode;
   Object m_bindings;
+  bool m_lazyMapping = false;
+
+  /** Value mapped once, the Value is referenced by mapped Functions */
+  struct SharedParameter {
+    Value m_value;
+    JSAtom m_name;
+    JSValue m_mapped;
+  };
+  map<string, SharedParameter> m_sharedParameters;
+
+  /** Parsed parameters, released when their handle has expired */
+  struct Parsed {
+    weak_ptr<const void> m_handle;
+    JSValue m_value;
+  };
+  vector<Parsed> m_parsed;
+  /** JS_ParseJSON requires a zero terminated string */
+  string m_json;
+
+  JSValue parseJson(string_view parameters) {
+    m_json.assign(parameters.data(), parameters.size());
+    JSValue json =
+        JS_ParseJSON(m_context, m_json.c_str(), m_json.size(), "<json>");
+    if (!JS_IsObject(json)) {
+      JS_FreeValue(m_context, json);
+      throw Exception("SyntaxError: 'parameters' is not an object");
+    }
+    return json;
+  }
+
+  /**
+   * Shallow copy of parsed parameters, so shared parameters and fields
+   * assigned by a view don't stick to them.
+   */
+  JSValue copyOf(JSValueConst parsed) {
+    JSPropertyEnum *names = nullptr;
+    uint32_t count = 0;
+    if (JS_GetOwnPropertyNames(m_context, &names, &count, parsed,
+                               JS_GPN_STRING_MASK | JS_GPN_ENUM_ONLY) < 0) {
+      throw Exception("could not copy 'parameters'");
+    }
+
+    JSValue copy = (JS_IsArray(m_context, parsed) > 0)
+                       ? JS_NewArray(m_context)
+                       : JS_NewObject(m_context);
+    for (uint32_t i = 0; i < count; ++i) {
+      JSValue value = JS_GetProperty(m_context, parsed, names[i].atom);
+      JS_DefinePropertyValue(m_context, copy, names[i].atom, value,
+                             JS_PROP_C_W_E);
+      JS_FreeAtom(m_context, names[i].atom);
+    }
+    js_free(m_context, names);
+    return copy;
+  }
+
+  void releaseParsed() {
+    auto expired = stable_partition(
+        m_parsed.begin(), m_parsed.end(),
+        [](const Parsed &parsed) { return !parsed.m_handle.expired(); });
+    for (auto it = expired; it != m_parsed.end(); ++it) {
+      JS_FreeValue(m_context, it->m_value);
+    }
+    m_parsed.erase(expired, m_parsed.end());
+  }
+
+  void removeSharedParameter(const string &name, const lock_guard<mutex> &) {
+    auto it = m_sharedParameters.find(name);
+    if (it != m_sharedParameters.end()) {
+      freeSharedParameter(it->second);
+      m_sharedParameters.erase(it);
+    }
+  }
+
+  void freeSharedParameter(SharedParameter &shared) {
+    JS_FreeValue(m_context, shared.m_mapped);
+    JS_FreeAtom(m_context, shared.m_name);
+  }
+
+  /** Fields of the parameters take precedence over shared parameters */
+  void addSharedParameters(JSValue parameters) {
+    for (const auto &[name, shared] : m_sharedParameters) {
+      if (JS_GetOwnProperty(m_context, nullptr, parameters, shared.m_name) ==
+          0) {
+        JS_DefinePropertyValue(m_context, parameters, shared.m_name,
+                               JS_DupValue(m_context, shared.m_mapped),
+                               JS_PROP_C_W_E);
+      }
+    }
+  }
 
   void render(const string &view, JSValue parameters, Stream &stream) {
+    addSharedParameters(parameters);
+
     JSValue argv[3];
     argv[0] = JS_NewStringLen(m_context, view.c_str(), view.length());
     argv[1] = parameters;
@@ -114,6 +277,12 @@ private:
     QuickJsHelper::evaluate(context, source);
     return QuickJsHelper::getFunction(context, "render");
   }
+
+  static JSValue evaluateSource(JSContext *context,
+                                const QuickJsBytecode &bytecode) {
+    QuickJsHelper::evaluate(context, bytecode.data());
+    return QuickJsHelper::getFunction(context, "render");
+  }
 };
 
 QuickJsRenderer::QuickJsRenderer(const string &source)
@@ -124,6 +293,16 @@ QuickJsRenderer::QuickJsRenderer(const string &source,
                                  Object bindings)
     : m_impl(make_unique<Impl>(source, prototypes, move(bindings))) {}
 
+QuickJsRenderer::QuickJsRenderer(const QuickJsBytecode &bytecode)
+    : QuickJsRenderer(bytecode, {}, {}) {}
+
+QuickJsRenderer::QuickJsRenderer(const QuickJsBytecode &bytecode,
+                                 const std::vector<Prototype> &prototypes,
+                                 Object bindings)
+    : m_impl(make_unique<Impl>(bytecode, prototypes, move(bindings))) {}
+
+QuickJsRenderer::QuickJsRenderer(QuickJsRenderer &&other) noexcept = default;
+
 QuickJsRenderer::~QuickJsRenderer() = default;
 
 void QuickJsRenderer::render(const string &view, const Object &parameters,
@@ -133,5 +312,47 @@ void QuickJsRenderer::render(const string &view, const Object &parameters,
 
 void QuickJsRenderer::render(const string &view, const string &parameters,
                              Stream &stream) {
+  m_impl->render(view, string_view(parameters), stream);
+}
+
+void QuickJsRenderer::render(const string &view, string_view parameters,
+                             Stream &stream) {
   m_impl->render(view, parameters, stream);
 }
+
+ParsedParameters QuickJsRenderer::parse(string_view parameters) {
+  return m_impl->parse(parameters);
+}
+
+void QuickJsRenderer::render(const string &view,
+                             const ParsedParameters &parameters,
+                             Stream &stream) {
+  m_impl->render(view, parameters, stream);
+}
+
+string QuickJsRenderer::renderToString(const string &view,
+                                       const ParsedParameters &parameters) {
+  auto stream = StringStream();
+  render(view, parameters, stream);
+  return stream.str();
+}
+
+void QuickJsRenderer::setLazyMapping(bool enabled) {
+  m_impl->setLazyMapping(enabled);
+}
+
+void QuickJsRenderer::setSharedParameter(const string &name, Value value) {
+  m_impl->setSharedParameter(name, move(value));
+}
+
+void QuickJsRenderer::removeSharedParameter(const string &name) {
+  m_impl->removeSharedParameter(name);
+}
+
+void QuickJsRenderer::setMemoCache(shared_ptr<MemoCache> cache) {
+  m_impl->setMemoCache(move(cache));
+}
+
+void QuickJsRenderer::setHtmlEncode(bool enabled) {
+  m_impl->setHtmlEncode(enabled);
+}
@@ -15,6 +15,8 @@
  */
 #include "complate/quickjs/quickjsrendererbuilder.h"
 
+#include <mutex>
+
 using namespace std;
 using namespace complate;
 
@@ -23,13 +25,33 @@ public:
   void source(string sourceObj) {
     m_source = move(sourceObj);
     m_sourceCreator = {};
+    resetPrecompiled();
   }
 
   void source(SourceCreator sourceCreator) {
     m_source = {};
     m_sourceCreator = move(sourceCreator);
+    resetPrecompiled();
+  }
+
+  void bytecode(QuickJsBytecode bytecodeObj) {
+    m_bytecode = make_shared<const QuickJsBytecode>(move(bytecodeObj));
+  }
+
+  void precompile(bool enabled) {
+    m_precompiled = (enabled) ? make_shared<Precompiled>() : nullptr;
   }
 
+  void htmlEncode(bool enabled) { m_htmlEncode = enabled; }
+
+  void lazyMapping(bool enabled) { m_lazyMapping = enabled; }
+
+  void sharedParameters(Object parameters) {
+    m_sharedParameters = move(parameters);
+  }
+
+  void memoCache(shared_ptr<MemoCache> cache) { m_memoCache = move(cache); }
+
   void bindings(Object bindingsObj) {
     m_bindings = move(bindingsObj);
     m_bindingsCreator = {};
@@ -51,16 +73,24 @@ public:
   }
 
   [[nodiscard]] QuickJsRenderer build() const {
-    return {(m_sourceCreator) ? invoke(m_sourceCreator) : m_source,
-            (m_prototypesCreator) ? invoke(m_prototypesCreator) : m_prototypes,
-            (m_bindingsCreator) ? invoke(m_bindingsCreator) : m_bindings};
+    auto bytecodeObj = makeBytecode();
+    QuickJsRenderer renderer =
+        (bytecodeObj)
+            ? QuickJsRenderer(*bytecodeObj, makePrototypes(), makeBindings())
+            : QuickJsRenderer(makeSource(), makePrototypes(), makeBindings());
+    configure(renderer);
+    return renderer;
   }
 
   [[nodiscard]] unique_ptr<QuickJsRenderer> unique() const {
-    return make_unique<QuickJsRenderer>(
-        (m_sourceCreator) ? invoke(m_sourceCreator) : m_source,
-        (m_prototypesCreator) ? invoke(m_prototypesCreator) : m_prototypes,
-        (m_bindingsCreator) ? invoke(m_bindingsCreator) : m_bindings);
+    auto bytecodeObj = makeBytecode();
+    auto renderer =
+        (bytecodeObj) ? make_unique<QuickJsRenderer>(
+                            *bytecodeObj, makePrototypes(), makeBindings())
+                      : make_unique<QuickJsRenderer>(
+                            makeSource(), makePrototypes(), makeBindings());
+    configure(*renderer);
+    return renderer;
   }
 
   [[nodiscard]] Renderer::Creator creator() const {
@@ -70,12 +100,69 @@ public:
   }
 
 private:
+  /** Bytecode compiled on first use, shared by all copies of this Impl */
+  struct Precompiled {
+    once_flag m_once;
+    shared_ptr<const QuickJsBytecode> m_bytecode;
+  };
+
   string m_source;
   SourceCreator m_sourceCreator;
   Object m_bindings;
   BindingsCreator m_bindingsCreator;
   vector<Prototype> m_prototypes;
   PrototypesCreator m_prototypesCreator;
+  bool m_htmlEncode = false;
+  bool m_lazyMapping = false;
+  Object m_sharedParameters;
+  shared_ptr<MemoCache> m_memoCache;
+  shared_ptr<const QuickJsBytecode> m_bytecode;
+  shared_ptr<Precompiled> m_precompiled;
+
+  void configure(QuickJsRenderer &renderer) const {
+    renderer.setLazyMapping(m_lazyMapping);
+    for (const auto &[name, value] : m_sharedParameters) {
+      renderer.setSharedParameter(name, value);
+    }
+    if (m_memoCache) {
+      renderer.setMemoCache(m_memoCache);
+    }
+    if (m_htmlEncode) {
+      renderer.setHtmlEncode(true);
+    }
+  }
+
+  void resetPrecompiled() {
+    if (m_precompiled) {
+      m_precompiled = make_shared<Precompiled>();
+    }
+  }
+
+  [[nodiscard]] string makeSource() const {
+    return (m_sourceCreator) ? invoke(m_sourceCreator) : m_source;
+  }
+
+  [[nodiscard]] vector<Prototype> makePrototypes() const {
+    return (m_prototypesCreator) ? invoke(m_prototypesCreator) : m_prototypes;
+  }
+
+  [[nodiscard]] Object makeBindings() const {
+    return (m_bindingsCreator) ? invoke(m_bindingsCreator) : m_bindings;
+  }
+
+  [[nodiscard]] shared_ptr<const QuickJsBytecode> makeBytecode() const {
+    if (m_bytecode) {
+      return m_bytecode;
+    } else if (m_precompiled) {
+      call_once(m_precompiled->m_once, [this] {
+        m_precompiled->m_bytecode = make_shared<const QuickJsBytecode>(
+            QuickJsBytecode::compile(makeSource()));
+      });
+      return m_precompiled->m_bytecode;
+    } else {
+      return nullptr;
+    }
+  }
 };
 
 QuickJsRendererBuilder::QuickJsRendererBuilder()
@@ -94,6 +181,39 @@ QuickJsRendererBuilder &QuickJsRendererBuilder::source(
   return *this;
 }
 
+QuickJsRendererBuilder &QuickJsRendererBuilder::bytecode(
+    QuickJsBytecode bytecodeObj) {
+  m_impl->bytecode(move(bytecodeObj));
+  return *this;
+}
+
+QuickJsRendererBuilder &QuickJsRendererBuilder::precompile(bool enabled) {
+  m_impl->precompile(enabled);
+  return *this;
+}
+
+QuickJsRendererBuilder &QuickJsRendererBuilder::htmlEncode(bool enabled) {
+  m_impl->htmlEncode(enabled);
+  return *this;
+}
+
+QuickJsRendererBuilder &QuickJsRendererBuilder::lazyMapping(bool enabled) {
+  m_impl->lazyMapping(enabled);
+  return *this;
+}
+
+QuickJsRendererBuilder &QuickJsRendererBuilder::sharedParameters(
+    Object parameters) {
+  m_impl->sharedParameters(move(parameters));
+  return *this;
+}
+
+QuickJsRendererBuilder &QuickJsRendererBuilder::memoCache(
+    shared_ptr<MemoCache> cache) {
+  m_impl->memoCache(move(cache));
+  return *this;
+}
+
 QuickJsRendererBuilder &QuickJsRendererBuilder::bindings(Object bindingsObj) {
   m_impl->bindings(move(bindingsObj));
   return *this;
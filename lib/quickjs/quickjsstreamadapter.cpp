@@ -33,6 +33,15 @@ JSValue QuickJsStreamAdapter::adapterFor(Stream &stream) {
   return v;
 }
 
+Stream *QuickJsStreamAdapter::streamOf(JSContext *ctx, JSValueConst value) {
+  /* The adapter is the class prototype, a plain object holding the Stream */
+  JSValue proto = JS_GetClassProto(ctx, ms_class_id);
+  const bool isAdapter = JS_VALUE_GET_TAG(value) == JS_TAG_OBJECT &&
+                         JS_VALUE_GET_PTR(value) == JS_VALUE_GET_PTR(proto);
+  JS_FreeValue(ctx, proto);
+  return (isAdapter) ? static_cast<Stream *>(JS_GetOpaque(value, 1)) : nullptr;
+}
+
 void QuickJsStreamAdapter::registerClass(JSContext *context) {
   if (ms_class_id == 0) {
     JS_NewClassID(&ms_class_id);
@@ -56,22 +65,12 @@ void QuickJsStreamAdapter::registerClass(JSContext *context) {
 
 JSValue QuickJsStreamAdapter::write(JSContext *ctx, JSValueConst this_val, int,
                                     JSValueConst *argv) {
-  auto *stream = static_cast<Stream *>(JS_GetOpaque2(ctx, this_val, 1));
-  size_t len;
-  const char *str = JS_ToCStringLen(ctx, &len, argv[0]);
-  stream->write(str, (int)len);
-  JS_FreeCString(ctx, str);
-  return JS_UNDEFINED;
+  return forward(ctx, this_val, argv[0], &Stream::write);
 }
 
 JSValue QuickJsStreamAdapter::writeln(JSContext *ctx, JSValueConst this_val,
                                       int, JSValueConst *argv) {
-  auto *stream = static_cast<Stream *>(JS_GetOpaque2(ctx, this_val, 1));
-  size_t len;
-  const char *str = JS_ToCStringLen(ctx, &len, argv[0]);
-  stream->writeln(str, (int)len);
-  JS_FreeCString(ctx, str);
-  return JS_UNDEFINED;
+  return forward(ctx, this_val, argv[0], &Stream::writeln);
 }
 
 JSValue QuickJsStreamAdapter::flush(JSContext *ctx, JSValueConst this_val, int,
@@ -80,3 +79,25 @@ JSValue QuickJsStreamAdapter::flush(JSContext *ctx, JSValueConst this_val, int,
   stream->flush();
   return JS_UNDEFINED;
 }
+
+JSValue QuickJsStreamAdapter::forward(JSContext *ctx, JSValueConst this_val,
+                                      JSValueConst str,
+                                      void (Stream::*fn)(const char *, int)) {
+  auto *stream = static_cast<Stream *>(JS_GetOpaque2(ctx, this_val, 1));
+  if (stream == nullptr) {
+    return JS_EXCEPTION;
+  }
+
+  /* For 8-bit strings with ASCII characters only, QuickJS returns a pointer
+   * to the internal buffer of the string without allocating. All other
+   * strings are converted to an UTF-8 copy. */
+  size_t len;
+  const char *cstr = JS_ToCStringLen(ctx, &len, str);
+  if (cstr == nullptr) {
+    return JS_EXCEPTION;
+  }
+
+  CStringGuard guard{ctx, cstr};
+  (stream->*fn)(cstr, (int)len);
+  return JS_UNDEFINED;
+}
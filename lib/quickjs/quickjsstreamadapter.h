@@ -31,6 +31,9 @@ public:
 
   JSValue adapterFor(Stream &stream);
 
+  /** The Stream of an adapter or nullptr, if the value isn't one */
+  static Stream *streamOf(JSContext *ctx, JSValueConst value);
+
 private:
   JSContext *m_context;
   static JSClassID ms_class_id;
@@ -44,6 +47,18 @@ private:
   static JSValue flush(JSContext *ctx, JSValueConst this_val, int argc,
                        JSValueConst *argv);
 
+  /** Forward a string to the Stream, without copying it where possible. */
+  static JSValue forward(JSContext *ctx, JSValueConst this_val,
+                         JSValueConst str,
+                         void (Stream::*fn)(const char *, int));
+
+  /** Frees the C string, even if the Stream throws. */
+  struct CStringGuard {
+    JSContext *m_ctx;
+    const char *m_str;
+    ~CStringGuard() { JS_FreeCString(m_ctx, m_str); }
+  };
+
   static constexpr std::array<JSCFunctionListEntry, 3> MSCE_FUNCTIONS{
       QuickJsFunctionListEntry::cfunc("write", 1, write),
       QuickJsFunctionListEntry::cfunc("writeln", 1, writeln),
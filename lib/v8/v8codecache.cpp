@@ -0,0 +1,68 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/v8/v8codecache.h>
+
+using namespace complate;
+using namespace std;
+
+V8CodeCache::V8CodeCache() = default;
+
+V8CodeCache::~V8CodeCache() = default;
+
+uint64_t V8CodeCache::keyFor(string_view source) {
+  /* 64-bit FNV-1a, mixed with the length to make collisions less likely */
+  uint64_t hash = 14695981039346656037ULL;
+  for (unsigned char c : source) {
+    hash ^= c;
+    hash *= 1099511628211ULL;
+  }
+  return hash ^ (uint64_t)source.size();
+}
+
+shared_ptr<const V8CodeCache::Data> V8CodeCache::get(uint64_t key) const {
+  lock_guard<mutex> guard(m_mutex);
+  auto it = m_entries.find(key);
+  return (it != m_entries.end()) ? it->second : nullptr;
+}
+
+void V8CodeCache::put(uint64_t key, Data data) {
+  auto entry = make_shared<const Data>(move(data));
+  lock_guard<mutex> guard(m_mutex);
+  m_entries[key] = move(entry);
+}
+
+shared_ptr<const V8CodeCache::Data> V8CodeCache::consume(uint64_t key) {
+  lock_guard<mutex> guard(m_mutex);
+  auto it = m_entries.find(key);
+  if (it != m_entries.end()) {
+    ++m_stats.hits;
+    return it->second;
+  } else {
+    ++m_stats.misses;
+    return nullptr;
+  }
+}
+
+void V8CodeCache::reject(uint64_t key) {
+  lock_guard<mutex> guard(m_mutex);
+  m_entries.erase(key);
+  ++m_stats.rejections;
+}
+
+V8CodeCache::Stats V8CodeCache::stats() const {
+  lock_guard<mutex> guard(m_mutex);
+  return m_stats;
+}
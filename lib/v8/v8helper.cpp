@@ -15,6 +15,11 @@
  */
 #include "v8helper.h"
 
+#include <complate/core/exception.h>
+
+#include <memory>
+
+using namespace complate;
 using namespace std;
 
 v8::Local<v8::String> V8Helper::newString(v8::Isolate *isolate,
@@ -23,3 +28,50 @@ v8::Local<v8::String> V8Helper::newString(v8::Isolate *isolate,
                                  v8::NewStringType::kNormal, (int)str.size())
       .ToLocalChecked();
 }
+
+void V8Helper::evaluate(v8::Local<v8::Context> context, string_view source,
+                        V8CodeCache *codeCache) {
+  v8::Isolate *isolate = context->GetIsolate();
+  const uint64_t key = (codeCache) ? V8CodeCache::keyFor(source) : 0;
+  shared_ptr<const V8CodeCache::Data> data =
+      (codeCache) ? codeCache->consume(key) : nullptr;
+
+  /* Source takes ownership of CachedData, but not of the buffer */
+  v8::ScriptCompiler::Source src(
+      newString(isolate, source),
+      (data) ? new v8::ScriptCompiler::CachedData(data->data(),
+                                                  (int)data->size())
+             : nullptr);
+  v8::TryCatch tryCatch(isolate);
+  v8::Local<v8::Script> script;
+  if (!v8::ScriptCompiler::Compile(
+           context, &src,
+           (data) ? v8::ScriptCompiler::kConsumeCodeCache
+                  : v8::ScriptCompiler::kNoCompileOptions)
+           .ToLocal(&script)) {
+    throwException(isolate, tryCatch);
+  }
+  const bool rejected = data && src.GetCachedData()->rejected;
+  if (rejected) {
+    codeCache->reject(key);
+  }
+  if (script->Run(context).IsEmpty()) {
+    throwException(isolate, tryCatch);
+  }
+
+  /* Created after running to include the functions compiled meanwhile */
+  if (codeCache && (!data || rejected)) {
+    unique_ptr<v8::ScriptCompiler::CachedData> created(
+        v8::ScriptCompiler::CreateCodeCache(script->GetUnboundScript()));
+    if (created) {
+      codeCache->put(key, V8CodeCache::Data(created->data,
+                                            created->data + created->length));
+    }
+  }
+}
+
+void V8Helper::throwException(v8::Isolate *isolate,
+                              const v8::TryCatch &tryCatch) {
+  v8::String::Utf8Value msg(isolate, tryCatch.Message()->Get());
+  throw Exception(*msg);
+}
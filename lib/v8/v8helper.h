@@ -15,6 +15,7 @@
  */
 #pragma once
 
+#include <complate/v8/v8codecache.h>
 #include <v8/v8.h>
 
 #include <string_view>
@@ -23,4 +24,20 @@ class V8Helper {
 public:
   static v8::Local<v8::String> newString(v8::Isolate* isolate,
                                          std::string_view str);
+
+  /**
+   * Compile and run a script in a context.
+   *
+   * When a code cache is passed, it's code cache data will be consumed or
+   * created and stored after the script did run.
+   *
+   * @throws complate::Exception when compiling or running the script fails.
+   */
+  static void evaluate(v8::Local<v8::Context> context,
+                       std::string_view source,
+                       complate::V8CodeCache* codeCache = nullptr);
+
+  /** Throw the caught exception as complate::Exception */
+  [[noreturn]] static void throwException(v8::Isolate* isolate,
+                                          const v8::TryCatch& tryCatch);
 };
@@ -0,0 +1,86 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include "v8htmlencode.h"
+
+#include <complate/core/htmlencode.h>
+
+#include <string>
+
+#include "v8helper.h"
+
+using namespace complate;
+using namespace std;
+
+V8HtmlEncode::V8HtmlEncode(v8::Isolate *isolate) : m_isolate(isolate) {}
+
+void V8HtmlEncode::setEnabled(v8::Local<v8::Context> context, bool enabled) {
+  if (enabled == m_installed) {
+    return;
+  }
+
+  v8::Local<v8::Object> global = context->Global();
+  v8::Local<v8::String> name = V8Helper::newString(m_isolate, "htmlEncode");
+  if (enabled) {
+    if (!global->HasOwnProperty(context, name).FromMaybe(true)) {
+      global
+          ->Set(context, name,
+                v8::FunctionTemplate::New(m_isolate, encode)
+                    ->GetFunction(context)
+                    .ToLocalChecked())
+          .Check();
+      m_installed = true;
+    }
+  } else {
+    global->Delete(context, name).Check();
+    m_installed = false;
+  }
+}
+
+void V8HtmlEncode::encode(const v8::FunctionCallbackInfo<v8::Value> &args) {
+  v8::Isolate *isolate = args.GetIsolate();
+  v8::Local<v8::String> str;
+  if (!args[0]->ToString(isolate->GetCurrentContext()).ToLocal(&str)) {
+    return;
+  }
+  const bool attribute = args[1]->BooleanValue(isolate);
+
+  /* Latin-1 strings are scanned byte-wise, the others as UTF-8 */
+  if (str->IsOneByte()) {
+    thread_local string buffer;
+    buffer.resize(str->Length());
+    str->WriteOneByte(isolate, reinterpret_cast<uint8_t *>(buffer.data()), 0,
+                      (int)buffer.size(), v8::String::NO_NULL_TERMINATION);
+    if (HtmlEncode::find(buffer, attribute) == string_view::npos) {
+      args.GetReturnValue().Set(str);
+      return;
+    }
+    const string encoded = HtmlEncode::encode(buffer, attribute);
+    args.GetReturnValue().Set(
+        v8::String::NewFromOneByte(
+            isolate, reinterpret_cast<const uint8_t *>(encoded.data()),
+            v8::NewStringType::kNormal, (int)encoded.size())
+            .ToLocalChecked());
+  } else {
+    v8::String::Utf8Value utf8(isolate, str);
+    const string_view view(*utf8, utf8.length());
+    if (HtmlEncode::find(view, attribute) == string_view::npos) {
+      args.GetReturnValue().Set(str);
+      return;
+    }
+    args.GetReturnValue().Set(
+        V8Helper::newString(isolate, HtmlEncode::encode(view, attribute)));
+  }
+}
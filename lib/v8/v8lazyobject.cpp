@@ -0,0 +1,148 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include "v8lazyobject.h"
+
+#include "v8renderercontext.h"
+
+using namespace complate;
+using namespace std;
+
+V8LazyObject::V8LazyObject(v8::Isolate *isolate) : m_isolate(isolate) {
+  v8::Locker locker(m_isolate);
+  v8::HandleScope scope(m_isolate);
+  auto tmpl = v8::ObjectTemplate::New(m_isolate);
+  tmpl->SetInternalFieldCount(FIELD_COUNT);
+
+  /* Non-masking: only consulted for properties not found otherwise */
+  const auto flags = static_cast<v8::PropertyHandlerFlags>(
+      static_cast<int>(v8::PropertyHandlerFlags::kNonMasking) |
+      static_cast<int>(v8::PropertyHandlerFlags::kOnlyInterceptStrings));
+  tmpl->SetHandler(v8::NamedPropertyHandlerConfiguration(
+      getter, setter, query, deleter, enumerator, v8::Local<v8::Value>(),
+      flags));
+  m_template.Reset(m_isolate, tmpl);
+}
+
+v8::Local<v8::Object> V8LazyObject::newInstance(const Object &object,
+                                                uint32_t scope) {
+  auto obj = m_template.Get(m_isolate)
+                 ->NewInstance(m_isolate->GetCurrentContext())
+                 .ToLocalChecked();
+  obj->SetInternalField(OBJECT,
+                        v8::External::New(m_isolate, (void *)&object));
+  obj->SetInternalField(SCOPE, v8::Integer::NewFromUnsigned(m_isolate, scope));
+  obj->SetInternalField(SHADOWED, v8::Set::New(m_isolate));
+  return obj;
+}
+
+const Value *V8LazyObject::find(v8::Isolate *isolate,
+                                v8::Local<v8::Name> property,
+                                v8::Local<v8::Object> holder) {
+  auto rctx = V8RendererContext::get(isolate);
+  auto scope = holder->GetInternalField(SCOPE).As<v8::Integer>()->Value();
+  if (!property->IsString() || rctx == nullptr ||
+      scope != rctx->proxyHolder().scope()) {
+    return nullptr;
+  }
+
+  auto shadowed = holder->GetInternalField(SHADOWED).As<v8::Set>();
+  if (shadowed->Has(isolate->GetCurrentContext(), property).FromMaybe(true)) {
+    return nullptr;
+  }
+
+  auto object = static_cast<const Object *>(
+      holder->GetInternalField(OBJECT).As<v8::External>()->Value());
+  v8::String::Utf8Value key(isolate, property);
+  auto it = object->find(string(*key, key.length()));
+  return (it != object->cend()) ? &it->second : nullptr;
+}
+
+void V8LazyObject::shadow(v8::Isolate *isolate, v8::Local<v8::Name> property,
+                          v8::Local<v8::Object> holder) {
+  auto shadowed = holder->GetInternalField(SHADOWED).As<v8::Set>();
+  shadowed->Add(isolate->GetCurrentContext(), property).ToLocalChecked();
+}
+
+void V8LazyObject::getter(v8::Local<v8::Name> property,
+                          const v8::PropertyCallbackInfo<v8::Value> &info) {
+  const Value *value = find(info.GetIsolate(), property, info.Holder());
+  if (value == nullptr) {
+    return;
+  }
+
+  auto rctx = V8RendererContext::get(info.GetIsolate());
+  v8::Local<v8::Value> result = rctx->mapper().fromValueLazy(*value);
+  /* Shadowed first, defining the property consults the setter */
+  shadow(info.GetIsolate(), property, info.Holder());
+  info.Holder()
+      ->CreateDataProperty(info.GetIsolate()->GetCurrentContext(), property,
+                           result)
+      .ToChecked();
+  info.GetReturnValue().Set(result);
+}
+
+void V8LazyObject::setter(v8::Local<v8::Name> property, v8::Local<v8::Value>,
+                          const v8::PropertyCallbackInfo<v8::Value> &info) {
+  /* Not intercepted, the value is defined as ordinary property */
+  if (find(info.GetIsolate(), property, info.Holder()) != nullptr) {
+    shadow(info.GetIsolate(), property, info.Holder());
+  }
+}
+
+void V8LazyObject::query(v8::Local<v8::Name> property,
+                         const v8::PropertyCallbackInfo<v8::Integer> &info) {
+  if (find(info.GetIsolate(), property, info.Holder()) != nullptr) {
+    info.GetReturnValue().Set(static_cast<int32_t>(v8::None));
+  }
+}
+
+void V8LazyObject::deleter(v8::Local<v8::Name> property,
+                           const v8::PropertyCallbackInfo<v8::Boolean> &info) {
+  /* Mapped fields are ordinary properties and deleted as such */
+  if (find(info.GetIsolate(), property, info.Holder()) != nullptr) {
+    shadow(info.GetIsolate(), property, info.Holder());
+    info.GetReturnValue().Set(true);
+  }
+}
+
+void V8LazyObject::enumerator(const v8::PropertyCallbackInfo<v8::Array> &info) {
+  v8::Isolate *isolate = info.GetIsolate();
+  auto context = isolate->GetCurrentContext();
+  auto rctx = V8RendererContext::get(isolate);
+  v8::Local<v8::Object> holder = info.Holder();
+  auto scope = holder->GetInternalField(SCOPE).As<v8::Integer>()->Value();
+  if (rctx == nullptr || scope != rctx->proxyHolder().scope()) {
+    info.GetReturnValue().Set(v8::Array::New(isolate));
+    return;
+  }
+
+  auto shadowed = holder->GetInternalField(SHADOWED).As<v8::Set>();
+  auto object = static_cast<const Object *>(
+      holder->GetInternalField(OBJECT).As<v8::External>()->Value());
+  auto keys = v8::Array::New(isolate);
+  uint32_t index = 0;
+  for (const auto &entry : *object) {
+    v8::Local<v8::String> key =
+        v8::String::NewFromUtf8(isolate, entry.first.c_str(),
+                                v8::NewStringType::kInternalized,
+                                (int)entry.first.size())
+            .ToLocalChecked();
+    if (!shadowed->Has(context, key).FromMaybe(true)) {
+      keys->Set(context, index++, key).ToChecked();
+    }
+  }
+  info.GetReturnValue().Set(keys);
+}
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <complate/core/value.h>
+#include <v8.h>
+
+#include <string>
+
+namespace complate {
+
+/**
+ * JS object which maps the fields of an Object on first access.
+ *
+ * The object is backed by named property interceptors. A mapped field is
+ * defined as ordinary property on the JS object and, since the interceptors
+ * are non-masking, every further access is served by V8 directly. The
+ * referenced Object must outlive the scope, after it changed the JS object
+ * appears to be empty.
+ *
+ * @note Fields named like a property of Object.prototype are hidden by it.
+ */
+class V8LazyObject {
+public:
+  explicit V8LazyObject(v8::Isolate *isolate);
+
+  v8::Local<v8::Object> newInstance(const Object &object, uint32_t scope);
+
+private:
+  enum Field { OBJECT, SCOPE, SHADOWED, FIELD_COUNT };
+
+  v8::Isolate *m_isolate;
+  v8::Persistent<v8::ObjectTemplate> m_template;
+
+  static const Value *find(v8::Isolate *isolate, v8::Local<v8::Name> property,
+                           v8::Local<v8::Object> holder);
+  static void shadow(v8::Isolate *isolate, v8::Local<v8::Name> property,
+                     v8::Local<v8::Object> holder);
+
+  static void getter(v8::Local<v8::Name> property,
+                     const v8::PropertyCallbackInfo<v8::Value> &info);
+  static void setter(v8::Local<v8::Name> property, v8::Local<v8::Value> value,
+                     const v8::PropertyCallbackInfo<v8::Value> &info);
+  static void query(v8::Local<v8::Name> property,
+                    const v8::PropertyCallbackInfo<v8::Integer> &info);
+  static void deleter(v8::Local<v8::Name> property,
+                      const v8::PropertyCallbackInfo<v8::Boolean> &info);
+  static void enumerator(const v8::PropertyCallbackInfo<v8::Array> &info);
+};
+}  // namespace complate
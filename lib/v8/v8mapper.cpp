@@ -20,7 +20,8 @@
 using namespace complate;
 using namespace std;
 
-V8Mapper::V8Mapper(v8::Isolate *isolate) : m_isolate(isolate) {}
+V8Mapper::V8Mapper(v8::Isolate *isolate)
+    : m_isolate(isolate), m_lazyObject(isolate) {}
 
 // NOLINTNEXTLINE(misc-no-recursion)
 v8::Local<v8::Object> V8Mapper::fromObject(const Object &object) {
@@ -38,6 +39,11 @@ v8::Local<v8::Object> V8Mapper::fromObject(const Object &object,
   return parent;
 }
 
+v8::Local<v8::Object> V8Mapper::fromObjectLazy(const Object &object) {
+  auto rctx = V8RendererContext::get(m_isolate);
+  return m_lazyObject.newInstance(object, rctx->proxyHolder().scope());
+}
+
 // NOLINTNEXTLINE(misc-no-recursion)
 v8::Local<v8::Array> V8Mapper::fromArray(const Array &d) {
   auto context = m_isolate->GetCurrentContext();
@@ -68,11 +74,59 @@ v8::Local<v8::Value> V8Mapper::fromValue(const Value &parameter) {
     return fromProxy(parameter.exactly<Proxy>());
   } else if (parameter.holds<ProxyWeak>()) {
     return fromProxyWeak(parameter.exactly<ProxyWeak>());
+  } else if (parameter.holds<SharedValue>()) {
+    return fromValue(parameter.exactly<SharedValue>().value());
   } else {
     return v8::Undefined(m_isolate);
   }
 }
 
+// NOLINTNEXTLINE(misc-no-recursion)
+v8::Local<v8::Value> V8Mapper::fromValueLazy(const Value &parameter) {
+  if (parameter.holds<SharedValue>()) {
+    return fromValueLazy(parameter.exactly<SharedValue>().value());
+  } else if (parameter.holds<Object>()) {
+    return fromObjectLazy(parameter.exactly<Object>());
+  } else if (parameter.holds<Array>()) {
+    /* A real array keeps Array.isArray and the Array prototype working */
+    const auto &d = parameter.exactly<Array>();
+    auto context = m_isolate->GetCurrentContext();
+    auto ar = v8::Array::New(m_isolate, (int)d.size());
+    for (uint32_t i = 0; i < d.size(); ++i) {
+      ar->Set(context, i, fromValueLazy(d[i])).ToChecked();
+    }
+    return ar;
+  } else {
+    return fromValue(parameter);
+  }
+}
+
+// NOLINTNEXTLINE(misc-no-recursion)
+v8::Local<v8::Value> V8Mapper::fromValueFrozen(const Value &parameter) {
+  auto context = m_isolate->GetCurrentContext();
+  v8::Local<v8::Object> result;
+  if (parameter.holds<SharedValue>()) {
+    return fromValueFrozen(parameter.exactly<SharedValue>().value());
+  } else if (parameter.holds<Object>()) {
+    result = v8::Object::New(m_isolate);
+    for (const auto &[k, v] : parameter.exactly<Object>()) {
+      v8::Local<v8::String> key = newInternalizedStringFrom(k);
+      result->Set(context, key, fromValueFrozen(v)).ToChecked();
+    }
+  } else if (parameter.holds<Array>()) {
+    const auto &d = parameter.exactly<Array>();
+    auto ar = v8::Array::New(m_isolate, (int)d.size());
+    for (uint32_t i = 0; i < d.size(); ++i) {
+      ar->Set(context, i, fromValueFrozen(d[i])).ToChecked();
+    }
+    result = ar;
+  } else {
+    return fromValue(parameter);
+  }
+  result->SetIntegrityLevel(context, v8::IntegrityLevel::kFrozen).ToChecked();
+  return result;
+}
+
 v8::Local<v8::Function> V8Mapper::fromFunction(const Function &d) {
   v8::Local<v8::External> fptr = v8::External::New(m_isolate, (void *)&d);
   return v8::FunctionTemplate::New(m_isolate, proxy, fptr)
@@ -18,6 +18,8 @@
 #include <complate/core/value.h>
 #include <v8.h>
 
+#include "v8lazyobject.h"
+
 namespace complate {
 
 class V8Mapper {
@@ -27,14 +29,18 @@ public:
   v8::Local<v8::Object> fromObject(const Object &object);
   v8::Local<v8::Object> fromObject(const Object &object,
                                    v8::Local<v8::Object> parent);
+  v8::Local<v8::Object> fromObjectLazy(const Object &object);
   v8::Local<v8::Array> fromArray(const Array &d);
   v8::Local<v8::Value> fromValue(const Value &parameter);
+  v8::Local<v8::Value> fromValueLazy(const Value &parameter);
+  v8::Local<v8::Value> fromValueFrozen(const Value &parameter);
   v8::Local<v8::Function> fromFunction(const Function &d);
   v8::Local<v8::Value> fromProxy(const Proxy &proxy);
   v8::Local<v8::Value> fromProxyWeak(const ProxyWeak &proxyWeak);
 
 private:
   v8::Isolate *m_isolate;
+  V8LazyObject m_lazyObject;
 
   inline v8::Local<v8::Value> valueFrom(Null);
   inline v8::Local<v8::Value> valueFrom(Bool d);
@@ -0,0 +1,107 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include "v8memo.h"
+
+#include <complate/core/exception.h>
+
+#include <string>
+
+#include "v8helper.h"
+#include "v8streamadapter.h"
+
+using namespace complate;
+using namespace std;
+
+V8Memo::V8Memo(v8::Isolate *isolate) : m_isolate(isolate) {}
+
+void V8Memo::install(v8::Local<v8::Context> context,
+                     shared_ptr<MemoCache> cache) {
+  m_cache = move(cache);
+  if (m_installed) {
+    return;
+  }
+  m_installed = true;
+
+  v8::Local<v8::Object> global = context->Global();
+  v8::Local<v8::String> name = V8Helper::newString(m_isolate, "memo");
+  if (global->HasOwnProperty(context, name).FromMaybe(true)) {
+    return;
+  }
+
+  auto data = v8::External::New(m_isolate, this);
+  v8::Local<v8::Object> native = v8::Object::New(m_isolate);
+  native
+      ->Set(context, V8Helper::newString(m_isolate, "replay"),
+            v8::FunctionTemplate::New(m_isolate, replay, data)
+                ->GetFunction(context)
+                .ToLocalChecked())
+      .Check();
+  native
+      ->Set(context, V8Helper::newString(m_isolate, "store"),
+            v8::FunctionTemplate::New(m_isolate, store, data)
+                ->GetFunction(context)
+                .ToLocalChecked())
+      .Check();
+
+  v8::TryCatch tryCatch(m_isolate);
+  v8::Local<v8::Script> script;
+  v8::Local<v8::Value> factory;
+  v8::Local<v8::Value> memo;
+  v8::Local<v8::Value> argv[1] = {native};
+  if (!v8::Script::Compile(
+           context, V8Helper::newString(m_isolate, MemoCache::script()))
+           .ToLocal(&script) ||
+      !script->Run(context).ToLocal(&factory) || !factory->IsFunction() ||
+      !factory.As<v8::Function>()
+           ->Call(context, v8::Undefined(m_isolate), 1, argv)
+           .ToLocal(&memo)) {
+    throw Exception("could not evaluate 'memo'");
+  }
+  global->Set(context, name, memo).Check();
+}
+
+V8Memo *V8Memo::memoOf(const v8::FunctionCallbackInfo<v8::Value> &args) {
+  return static_cast<V8Memo *>(args.Data().As<v8::External>()->Value());
+}
+
+void V8Memo::replay(const v8::FunctionCallbackInfo<v8::Value> &args) {
+  V8Memo *memo = memoOf(args);
+  v8::String::Utf8Value key(args.GetIsolate(), args[1]);
+  auto html =
+      (memo->m_cache) ? memo->m_cache->get({*key, (size_t)key.length()})
+                      : nullptr;
+  if (!html) {
+    return;
+  }
+
+  Stream *stream = V8StreamAdapter::streamOf(args[0]);
+  if (stream != nullptr) {
+    stream->write(html->data(), (int)html->size());
+    args.GetReturnValue().Set(true);
+  } else {
+    args.GetReturnValue().Set(V8Helper::newString(args.GetIsolate(), *html));
+  }
+}
+
+void V8Memo::store(const v8::FunctionCallbackInfo<v8::Value> &args) {
+  V8Memo *memo = memoOf(args);
+  v8::String::Utf8Value key(args.GetIsolate(), args[0]);
+  v8::String::Utf8Value html(args.GetIsolate(), args[1]);
+  if (memo->m_cache) {
+    memo->m_cache->put({*key, (size_t)key.length()},
+                       string(*html, html.length()));
+  }
+}
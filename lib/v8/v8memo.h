@@ -0,0 +1,48 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#pragma once
+
+#include <complate/core/memocache.h>
+#include <v8.h>
+
+#include <memory>
+
+namespace complate {
+
+/** Installs the `memo` binding backed by a MemoCache */
+class V8Memo {
+public:
+  explicit V8Memo(v8::Isolate *isolate);
+
+  /**
+   * Use the cache for `memo`, which is defined in the global object on first
+   * call, unless it already has a `memo`. Without a cache `memo` always
+   * renders the component.
+   */
+  void install(v8::Local<v8::Context> context,
+               std::shared_ptr<MemoCache> cache);
+
+private:
+  v8::Isolate *m_isolate;
+  std::shared_ptr<MemoCache> m_cache;
+  bool m_installed = false;
+
+  static V8Memo *memoOf(const v8::FunctionCallbackInfo<v8::Value> &args);
+
+  static void replay(const v8::FunctionCallbackInfo<v8::Value> &args);
+  static void store(const v8::FunctionCallbackInfo<v8::Value> &args);
+};
+}  // namespace complate
@@ -0,0 +1,115 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include "v8nativecall.h"
+
+#include <limits>
+
+#include "v8helper.h"
+#include "v8renderercontext.h"
+
+using namespace complate;
+using namespace std;
+
+V8NativeCall::V8NativeCall(const v8::FunctionCallbackInfo<v8::Value> &info)
+    : m_isolate(info.GetIsolate()),
+      m_info(&info),
+      m_return(info.GetReturnValue()),
+      m_failed(false) {}
+
+V8NativeCall::V8NativeCall(v8::Isolate *isolate,
+                           v8::ReturnValue<v8::Value> returnValue)
+    : m_isolate(isolate),
+      m_info(nullptr),
+      m_return(returnValue),
+      m_failed(false) {}
+
+int V8NativeCall::argc() const { return (m_info) ? m_info->Length() : 0; }
+
+bool V8NativeCall::failed() const { return m_failed; }
+
+bool V8NativeCall::toBool(int index) {
+  return arg(index)->BooleanValue(m_isolate);
+}
+
+int32_t V8NativeCall::toInt32(int index) {
+  return check(arg(index)->Int32Value(m_isolate->GetCurrentContext()), 0);
+}
+
+int64_t V8NativeCall::toInt64(int index) {
+  return check(arg(index)->IntegerValue(m_isolate->GetCurrentContext()),
+               int64_t(0));
+}
+
+double V8NativeCall::toDouble(int index) {
+  return check(arg(index)->NumberValue(m_isolate->GetCurrentContext()),
+               numeric_limits<double>::quiet_NaN());
+}
+
+string V8NativeCall::toString(int index) {
+  v8::String::Utf8Value str(m_isolate, arg(index));
+  if (!*str) {
+    m_failed = true;
+    return {};
+  }
+  return string(*str, str.length());
+}
+
+Value V8NativeCall::toValue(int index) {
+  auto rctx = V8RendererContext::get(m_isolate);
+  return rctx->unmapper().fromValue(arg(index));
+}
+
+void V8NativeCall::returnUndefined() { m_return.SetUndefined(); }
+
+void V8NativeCall::returnNull() { m_return.SetNull(); }
+
+void V8NativeCall::returnBool(bool value) { m_return.Set(value); }
+
+void V8NativeCall::returnInt32(int32_t value) { m_return.Set(value); }
+
+void V8NativeCall::returnUint32(uint32_t value) { m_return.Set(value); }
+
+void V8NativeCall::returnInt64(int64_t value) {
+  // a BigInt, like the V8Mapper does for a Number holding an int64_t
+  m_return.Set(v8::BigInt::New(m_isolate, value));
+}
+
+void V8NativeCall::returnDouble(double value) { m_return.Set(value); }
+
+void V8NativeCall::returnString(string_view value) {
+  m_return.Set(V8Helper::newString(m_isolate, value));
+}
+
+void V8NativeCall::returnValue(const Value &value) {
+  auto rctx = V8RendererContext::get(m_isolate);
+  m_return.Set(rctx->mapper().fromValue(value));
+}
+
+v8::Local<v8::Value> V8NativeCall::arg(int index) const {
+  // once a conversion threw, the remaining arguments are not converted
+  return (m_info && !m_failed && index < m_info->Length())
+             ? (*m_info)[index]
+             : v8::Local<v8::Value>(v8::Undefined(m_isolate));
+}
+
+template <typename T>
+T V8NativeCall::check(v8::Maybe<T> value, T fallback) {
+  if (value.IsNothing()) {
+    m_failed = true;
+    return fallback;
+  }
+  return value.FromJust();
+}
@@ -17,6 +17,7 @@
 
 #include <functional>
 
+#include "v8nativecall.h"
 #include "v8renderercontext.h"
 
 using namespace std;
@@ -28,27 +29,46 @@ V8PrototypeRegistry::V8PrototypeRegistry(v8::Isolate *isolate)
 void V8PrototypeRegistry::add(const Prototype &prototype) {
   v8::Locker locker(m_isolate);
   v8::HandleScope scope(m_isolate);
-  auto tmpl = v8::ObjectTemplate::New(m_isolate);
-  tmpl->SetInternalFieldCount(1);
+  /* the signatures let V8 reject receivers which are not instances of the
+   * constructor, before the callbacks read their internal field */
+  auto constructor = v8::FunctionTemplate::New(m_isolate);
+  auto signature = v8::Signature::New(m_isolate, constructor);
+  auto accessorSignature = v8::AccessorSignature::New(m_isolate, constructor);
+  auto tmpl = constructor->InstanceTemplate();
+  tmpl->SetInternalFieldCount(FIELD_COUNT);
 
   auto proto = make_unique<Prototype>(prototype);
+  auto members = make_unique<vector<Member>>();
+  members->reserve(proto->methods().size() + proto->properties().size());
   for (const auto &method : proto->methods()) {
+    members->push_back(Member{&method, nullptr});
     tmpl->Set(m_isolate, method.name().c_str(),
               v8::FunctionTemplate::New(
                   m_isolate, methodCall,
-                  v8::External::New(m_isolate, (void *)&method)));
+                  v8::External::New(m_isolate, &members->back()), signature));
   }
 
+  /* snapshot properties are data properties of the template, so all
+   * instances share the same hidden class */
+  vector<v8::Global<v8::String>> names;
   for (const auto &property : proto->properties()) {
-    tmpl->SetNativeDataProperty(
-        v8::String::NewFromUtf8(m_isolate, property.name().c_str(),
-                                v8::NewStringType::kInternalized)
-            .ToLocalChecked(),
-        getter, setter, v8::External::New(m_isolate, (void *)&property));
+    auto name = v8::String::NewFromUtf8(m_isolate, property.name().c_str(),
+                                        v8::NewStringType::kInternalized)
+                    .ToLocalChecked();
+    if (proto->snapshot()) {
+      tmpl->Set(name, v8::Undefined(m_isolate));
+      names.emplace_back(m_isolate, name);
+    } else {
+      members->push_back(Member{nullptr, &property});
+      tmpl->SetNativeDataProperty(
+          name, getter, setter, v8::External::New(m_isolate, &members->back()),
+          v8::None, accessorSignature);
+    }
   }
 
   m_entries.emplace(prototype.name(),
-                    Entry{make_unique<Template>(m_isolate, tmpl), move(proto)});
+                    Entry{make_unique<Template>(m_isolate, tmpl), move(proto),
+                          move(members), move(names)});
 }
 
 v8::Local<v8::Value> V8PrototypeRegistry::newInstanceOf(
@@ -69,40 +89,98 @@ v8::Local<v8::Value> V8PrototypeRegistry::newInstanceOf(const string &name,
     auto object = it->second.m_template->Get(m_isolate)
                       ->NewInstance(m_isolate->GetCurrentContext())
                       .ToLocalChecked();
-    object->SetInternalField(0, v8::External::New(m_isolate, ptr));
+    object->SetAlignedPointerInInternalField(OBJECT, ptr);
+    if (it->second.m_prototype->snapshot()) {
+      snapshot(it->second, object, ptr);
+    }
     return object;
   } else {
     return v8::Undefined(m_isolate);
   }
 }
 
+void V8PrototypeRegistry::snapshot(const Entry &entry,
+                                   v8::Local<v8::Object> object,
+                                   void *ptr) const {
+  auto context = m_isolate->GetCurrentContext();
+  auto rctx = V8RendererContext::get(m_isolate);
+  const auto &properties = entry.m_prototype->properties();
+  for (size_t i = 0; i < properties.size(); ++i) {
+    object
+        ->Set(context, entry.m_names[i].Get(m_isolate),
+              rctx->mapper().fromValue(properties[i].get(ptr)))
+        .ToChecked();
+  }
+}
+
+/* Called by V8ProxyDeleter outside of the renderer's Locker */
+void V8PrototypeRegistry::startCache() {
+  v8::Locker locker(m_isolate);
+  m_caching = true;
+}
+
+void V8PrototypeRegistry::clearCache() {
+  v8::Locker locker(m_isolate);
+  m_cache.clear();
+  m_caching = false;
+}
+
 void V8PrototypeRegistry::methodCall(
     const v8::FunctionCallbackInfo<v8::Value> &info) {
-  auto rctx = V8RendererContext::get(info.GetIsolate());
+  auto data = v8::Local<v8::External>::Cast(info.Data())->Value();
+  const auto &member = *static_cast<const Member *>(data);
+  auto method = member.m_method;
+  auto pptr = info.This()->GetAlignedPointerFromInternalField(OBJECT);
+
+  if (method->typed()) {
+    V8NativeCall call(info);
+    method->invoke(pptr, call);
+    return;
+  }
 
+  auto rctx = V8RendererContext::get(info.GetIsolate());
   Array args;
   for (int i = 0; i < info.Length(); ++i) {
     args.emplace_back(rctx->unmapper().fromValue(info[i]));
   }
 
-  auto pptr =
-      v8::Local<v8::External>::Cast(info.This()->GetInternalField(0))->Value();
-  auto data = v8::Local<v8::External>::Cast(info.Data())->Value();
-  auto method = static_cast<Method *>(data);
-
   info.GetReturnValue().Set(rctx->mapper().fromValue(method->apply(pptr, args)));
 }
 
 void V8PrototypeRegistry::getter(
     v8::Local<v8::String>, const v8::PropertyCallbackInfo<v8::Value> &info) {
   auto rctx = V8RendererContext::get(info.GetIsolate());
+  auto &registry = rctx->prototypeRegistry();
 
-  auto pptr =
-      v8::Local<v8::External>::Cast(info.This()->GetInternalField(0))->Value();
   auto data = v8::Local<v8::External>::Cast(info.Data())->Value();
-  auto prop = static_cast<Property *>(data);
+  const auto &member = *static_cast<const Member *>(data);
+  auto prop = member.m_property;
+  auto pptr = info.This()->GetAlignedPointerFromInternalField(OBJECT);
+
+  const bool cached = registry.m_caching && pptr && prop->pure();
+  if (cached) {
+    auto it = registry.m_cache.find({pptr, &member});
+    if (it != registry.m_cache.end()) {
+      info.GetReturnValue().Set(it->second);
+      return;
+    }
+  }
 
-  info.GetReturnValue().Set(rctx->mapper().fromValue(prop->get(pptr)));
+  v8::TryCatch tryCatch(info.GetIsolate());
+  if (prop->typed()) {
+    V8NativeCall call(info.GetIsolate(), info.GetReturnValue());
+    prop->invoke(pptr, call);
+  } else {
+    info.GetReturnValue().Set(rctx->mapper().fromValue(prop->get(pptr)));
+  }
+
+  if (tryCatch.HasCaught()) {
+    tryCatch.ReThrow();
+  } else if (cached) {
+    registry.m_cache.emplace(
+        CacheKey{pptr, &member},
+        v8::Global<v8::Value>(info.GetIsolate(), info.GetReturnValue().Get()));
+  }
 }
 
 void V8PrototypeRegistry::setter(v8::Local<v8::String>,
@@ -110,10 +188,10 @@ void V8PrototypeRegistry::setter(v8::Local<v8::String>,
                                  const v8::PropertyCallbackInfo<void> &info) {
   auto rctx = V8RendererContext::get(info.GetIsolate());
 
-  auto pptr =
-      v8::Local<v8::External>::Cast(info.This()->GetInternalField(0))->Value();
   auto data = v8::Local<v8::External>::Cast(info.Data())->Value();
-  auto prop = static_cast<Property *>(data);
+  const auto &member = *static_cast<const Member *>(data);
+  auto pptr = info.This()->GetAlignedPointerFromInternalField(OBJECT);
 
-  prop->set(pptr, rctx->unmapper().fromValue(value));
+  member.m_property->set(pptr, rctx->unmapper().fromValue(value));
+  rctx->prototypeRegistry().m_cache.erase({pptr, &member});
 }
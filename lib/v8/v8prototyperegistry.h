@@ -20,8 +20,10 @@
 #include <v8.h>
 
 #include <map>
-#include <string>
 #include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
 
 namespace complate {
 
@@ -35,18 +37,52 @@ public:
   [[nodiscard]] v8::Local<v8::Value> newInstanceOf(
       const ProxyWeak &proxyWeak) const;
 
+  /** Memoize the values of pure Property's until clearCache() */
+  void startCache();
+  /** Release the memoized values and stop memoizing */
+  void clearCache();
+
 private:
+  /** Internal fields of an instance, aligned pointers */
+  enum Field { OBJECT, FIELD_COUNT };
   using Template = v8::Persistent<v8::ObjectTemplate>;
+  struct Member {
+    const Method *m_method;
+    const Property *m_property;
+  };
   struct Entry {
     std::unique_ptr<Template> m_template;
     std::unique_ptr<Prototype> m_prototype;
+    /** Passed as data to the callbacks, never reallocated */
+    std::unique_ptr<std::vector<Member>> m_members;
+    /** Property names of a snapshot Prototype */
+    std::vector<v8::Global<v8::String>> m_names;
+  };
+  /** Values of pure Property's by object and Member */
+  struct CacheKey {
+    const void *m_object;
+    const Member *m_member;
+    bool operator==(const CacheKey &other) const {
+      return m_object == other.m_object && m_member == other.m_member;
+    }
+  };
+  struct CacheKeyHash {
+    size_t operator()(const CacheKey &key) const {
+      return std::hash<const void *>()(key.m_object) * 31 +
+             std::hash<const void *>()(key.m_member);
+    }
   };
   v8::Isolate *m_isolate;
   std::map<std::string, Entry> m_entries;
+  std::unordered_map<CacheKey, v8::Global<v8::Value>, CacheKeyHash> m_cache;
+  bool m_caching = false;
 
   [[nodiscard]] v8::Local<v8::Value> newInstanceOf(const std::string &name,
                                                    void *ptr) const;
 
+  void snapshot(const Entry &entry, v8::Local<v8::Object> object,
+                void *ptr) const;
+
   static void methodCall(const v8::FunctionCallbackInfo<v8::Value> &info);
 
   static void getter(v8::Local<v8::String>,
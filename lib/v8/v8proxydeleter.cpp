@@ -17,8 +17,18 @@
 
 using namespace complate;
 
-V8ProxyDeleter::V8ProxyDeleter(V8ProxyHolder& holder) : m_holder(holder) {}
+V8ProxyDeleter::V8ProxyDeleter(V8ProxyHolder& holder)
+    : m_holder(holder), m_registry(nullptr) {}
+
+V8ProxyDeleter::V8ProxyDeleter(V8ProxyHolder& holder,
+                               V8PrototypeRegistry& registry)
+    : m_holder(holder), m_registry(&registry) {
+  m_registry->startCache();
+}
 
 V8ProxyDeleter::~V8ProxyDeleter() {
+  if (m_registry) {
+    m_registry->clearCache();
+  }
   m_holder.clear();
 }
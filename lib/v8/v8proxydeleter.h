@@ -15,6 +15,7 @@
 */
 #pragma once
 
+#include "v8prototyperegistry.h"
 #include "v8proxyholder.h"
 
 namespace complate {
@@ -22,10 +23,13 @@ namespace complate {
 class V8ProxyDeleter {
 public:
   explicit V8ProxyDeleter(V8ProxyHolder &holder);
+  /** Also memoize pure Property values of the registry until destruction */
+  V8ProxyDeleter(V8ProxyHolder &holder, V8PrototypeRegistry &registry);
   ~V8ProxyDeleter();
 
 private:
   V8ProxyHolder &m_holder;
+  V8PrototypeRegistry *m_registry;
 };
 }
 
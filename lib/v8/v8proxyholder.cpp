@@ -24,4 +24,7 @@ void V8ProxyHolder::add(const Proxy& proxy) {
 
 void V8ProxyHolder::clear() {
   m_proxies.clear();
+  ++m_scope;
 }
+
+uint32_t V8ProxyHolder::scope() const { return m_scope; }
@@ -17,6 +17,7 @@
 
 #include <complate/core/proxy.h>
 
+#include <cstdint>
 #include <vector>
 
 namespace complate {
@@ -26,8 +27,12 @@ public:
   void add(const Proxy &proxy);
   void clear();
 
+  /** Generation which changes upon clear() */
+  [[nodiscard]] uint32_t scope() const;
+
 private:
   std::vector<Proxy> m_proxies;
+  uint32_t m_scope = 0;
 };
 
 }  // namespace complate
\ No newline at end of file
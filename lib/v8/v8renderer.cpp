@@ -14,12 +14,18 @@
  *  limitations under the License.
  */
 #include <complate/core/exception.h>
+#include <complate/core/stringstream.h>
 #include <complate/v8/v8renderer.h>
 #include <v8.h>
 
+#include <list>
+#include <map>
+#include <optional>
 #include <utility>
 
 #include "v8helper.h"
+#include "v8htmlencode.h"
+#include "v8memo.h"
 #include "v8renderercontext.h"
 #include "v8streamadapter.h"
 #include "v8proxydeleter.h"
@@ -29,11 +35,16 @@ using namespace std;
 
 class V8Renderer::Impl {
 public:
-  explicit Impl(const string &source, const std::vector<Prototype> &prototypes,
-                Object bindings)
-      : m_isolate(createIsolate()),
+  template <typename Source>
+  Impl(const Source &source, const std::vector<Prototype> &prototypes,
+       Object bindings, shared_ptr<V8CodeCache> codeCache)
+      : m_codeCache(move(codeCache)),
+        m_snapshot(snapshotOf(source)),
+        m_isolate(createIsolate()),
         m_rendererContext(m_isolate, prototypes),
         m_streamAdapter(m_isolate),
+        m_memo(m_isolate),
+        m_htmlEncode(m_isolate),
         m_bindings(move(bindings)) {
     V8ProxyDeleter proxyDeleter(m_rendererContext.proxyHolder());
     v8::Locker locker(m_isolate);
@@ -44,20 +55,7 @@ public:
     v8::Context::Scope context_scope(ctx);
 
     m_rendererContext.mapper().fromObject(m_bindings, ctx->Global());
-
-    v8::Local<v8::String> src = V8Helper::newString(m_isolate, source);
-    v8::TryCatch tryCatch(m_isolate);
-    v8::MaybeLocal<v8::Script> script = v8::Script::Compile(ctx, src);
-    if (tryCatch.HasCaught()) {
-      v8::String::Utf8Value msg(m_isolate, tryCatch.Message()->Get());
-      throw Exception(*msg);
-    }
-    v8::MaybeLocal<v8::Value> rc = script.ToLocalChecked()->Run(ctx);
-    (void)rc;
-    if (tryCatch.HasCaught()) {
-      v8::String::Utf8Value msg(m_isolate, tryCatch.Message()->Get());
-      throw Exception(*msg);
-    }
+    evaluateSource(ctx, source, m_codeCache.get());
 
     v8::Local<v8::Object> global = ctx->Global();
     v8::Local<v8::String> rnd = V8Helper::newString(m_isolate, "render");
@@ -71,50 +69,217 @@ public:
   ~Impl() { m_isolate->Dispose(); }
 
   void render(const string &view, const Object &parameters, Stream &stream) {
-    V8ProxyDeleter proxyDeleter(m_rendererContext.proxyHolder());
+    V8ProxyDeleter proxyDeleter(m_rendererContext.proxyHolder(),
+                                m_rendererContext.prototypeRegistry());
     v8::Locker locker(m_isolate);
     v8::HandleScope handle_scope(m_isolate);
     auto ctx = context();
     v8::Context::Scope context_scope(ctx);
 
-    render(view, m_rendererContext.mapper().fromObject(parameters), stream);
+    auto &mapper = m_rendererContext.mapper();
+    render(view,
+           (m_lazyMapping) ? mapper.fromObjectLazy(parameters)
+                           : mapper.fromObject(parameters),
+           stream);
   }
 
-  void render(const string &view, const string &parameters, Stream &stream) {
+  void render(const string &view, string_view parameters, Stream &stream) {
     v8::Locker locker(m_isolate);
     v8::HandleScope handle_scope(m_isolate);
     auto ctx = context();
     v8::Context::Scope context_scope(ctx);
 
-    v8::Local<v8::Value> p;
-    if (!v8::JSON::Parse(ctx, V8Helper::newString(m_isolate, parameters))
-             .ToLocal(&p)) {
-      throw Exception("SyntaxError: 'parameters' is not an object");
+    render(view, parseJson(ctx, parameters), stream);
+  }
+
+  ParsedParameters parse(string_view parameters) {
+    v8::Locker locker(m_isolate);
+    v8::HandleScope handle_scope(m_isolate);
+    auto ctx = context();
+    v8::Context::Scope context_scope(ctx);
+
+    releaseParsed(locker);
+    auto &parsed = m_parsed.emplace_back();
+    parsed.m_value.Reset(m_isolate, parseJson(ctx, parameters));
+    auto handle = make_shared<const v8::Persistent<v8::Value> *>(
+        &parsed.m_value);
+    parsed.m_handle = handle;
+    return ParsedParameters(this, move(handle));
+  }
+
+  void render(const string &view, const ParsedParameters &parameters,
+              Stream &stream) {
+    if (!parameters || parameters.owner() != this) {
+      throw Exception("'parameters' were not parsed by this renderer");
+    }
+    v8::Locker locker(m_isolate);
+    v8::HandleScope handle_scope(m_isolate);
+    auto ctx = context();
+    v8::Context::Scope context_scope(ctx);
+
+    const auto *json = *static_cast<const v8::Persistent<v8::Value> *const *>(
+        parameters.parsed());
+    /* Shallow copy, so shared parameters and fields assigned by a view
+     * don't stick to the parsed parameters */
+    v8::Local<v8::Value> value = json->Get(m_isolate);
+    if (value->IsObject()) {
+      value = value.As<v8::Object>()->Clone();
     }
+    render(view, value, stream);
+  }
+
+  void setLazyMapping(bool enabled) {
+    v8::Locker locker(m_isolate);
+    m_lazyMapping = enabled;
+  }
+
+  void setSharedParameter(const string &name, Value value) {
+    V8ProxyDeleter proxyDeleter(m_rendererContext.proxyHolder());
+    v8::Locker locker(m_isolate);
+    v8::HandleScope handle_scope(m_isolate);
+    auto ctx = context();
+    v8::Context::Scope context_scope(ctx);
 
-    render(view, p, stream);
+    removeSharedParameter(name, locker);
+    auto &shared = m_sharedParameters[name];
+    shared.m_value = move(value);
+    shared.m_name.Reset(m_isolate, V8Helper::newString(m_isolate, name));
+    shared.m_mapped.Reset(
+        m_isolate, m_rendererContext.mapper().fromValueFrozen(shared.m_value));
+  }
+
+  void removeSharedParameter(const string &name) {
+    v8::Locker locker(m_isolate);
+    removeSharedParameter(name, locker);
+  }
+
+  void setMemoCache(shared_ptr<MemoCache> cache) {
+    v8::Locker locker(m_isolate);
+    v8::HandleScope handle_scope(m_isolate);
+    auto ctx = context();
+    v8::Context::Scope context_scope(ctx);
+    m_memo.install(ctx, move(cache));
+  }
+
+  void setHtmlEncode(bool enabled) {
+    v8::Locker locker(m_isolate);
+    v8::HandleScope handle_scope(m_isolate);
+    auto ctx = context();
+    v8::Context::Scope context_scope(ctx);
+    m_htmlEncode.setEnabled(ctx, enabled);
   }
 
 private:
+  shared_ptr<V8CodeCache> m_codeCache;
+  /** The snapshot must outlive the isolate booted from it */
+  optional<V8Snapshot> m_snapshot;
+  v8::StartupData m_startupData{nullptr, 0};
   v8::Isolate *m_isolate;
   v8::Persistent<v8::Function> m_render;
   v8::Persistent<v8::Context> m_context;
   V8RendererContext m_rendererContext;
   V8StreamAdapter m_streamAdapter;
+  V8Memo m_memo;
+  V8HtmlEncode m_htmlEncode;
   Object m_bindings;
+  bool m_lazyMapping = false;
+
+  /** Value mapped once, the Value is referenced by mapped Functions */
+  struct SharedParameter {
+    Value m_value;
+    v8::Persistent<v8::String> m_name;
+    v8::Persistent<v8::Value> m_mapped;
+  };
+  map<string, SharedParameter> m_sharedParameters;
+
+  /** Parsed parameters, released when their handle has expired */
+  struct Parsed {
+    weak_ptr<const void> m_handle;
+    v8::Persistent<v8::Value> m_value;
+  };
+  /** A list, because handles point to the persistents */
+  list<Parsed> m_parsed;
 
   v8::Local<v8::Context> context() { return m_context.Get(m_isolate); }
 
-  static v8::Isolate *createIsolate() {
+  void removeSharedParameter(const string &name, const v8::Locker &) {
+    auto it = m_sharedParameters.find(name);
+    if (it != m_sharedParameters.end()) {
+      it->second.m_name.Reset();
+      it->second.m_mapped.Reset();
+      m_sharedParameters.erase(it);
+    }
+  }
+
+  v8::Local<v8::Value> parseJson(v8::Local<v8::Context> ctx,
+                                 string_view parameters) {
+    v8::Local<v8::Value> json;
+    if (!v8::JSON::Parse(ctx, V8Helper::newString(m_isolate, parameters))
+             .ToLocal(&json)) {
+      throw Exception("SyntaxError: 'parameters' is not an object");
+    }
+    return json;
+  }
+
+  void releaseParsed(const v8::Locker &) {
+    for (auto it = m_parsed.begin(); it != m_parsed.end();) {
+      if (it->m_handle.expired()) {
+        it->m_value.Reset();
+        it = m_parsed.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+
+  /** Fields of the parameters take precedence over shared parameters */
+  void addSharedParameters(const v8::Local<v8::Value> &parameters) {
+    if (m_sharedParameters.empty() || !parameters->IsObject()) {
+      return;
+    }
+
+    auto ctx = context();
+    auto obj = parameters.As<v8::Object>();
+    for (const auto &[name, shared] : m_sharedParameters) {
+      v8::Local<v8::String> key = shared.m_name.Get(m_isolate);
+      if (!obj->HasOwnProperty(ctx, key).FromMaybe(true)) {
+        obj->CreateDataProperty(ctx, key, shared.m_mapped.Get(m_isolate))
+            .ToChecked();
+      }
+    }
+  }
+
+  v8::Isolate *createIsolate() {
     v8::Isolate::CreateParams params;
     params.array_buffer_allocator =
         v8::ArrayBuffer::Allocator::NewDefaultAllocator();
+    if (m_snapshot) {
+      m_startupData.data = m_snapshot->data().data();
+      m_startupData.raw_size = (int)m_snapshot->data().size();
+      params.snapshot_blob = &m_startupData;
+    }
     return v8::Isolate::New(params);
   }
 
+  static optional<V8Snapshot> snapshotOf(const string &) { return nullopt; }
+
+  static optional<V8Snapshot> snapshotOf(const V8Snapshot &snapshot) {
+    return snapshot;
+  }
+
+  static void evaluateSource(v8::Local<v8::Context> ctx, const string &source,
+                             V8CodeCache *codeCache) {
+    V8Helper::evaluate(ctx, source, codeCache);
+  }
+
+  /** The source bundle has already been evaluated within the snapshot */
+  static void evaluateSource(v8::Local<v8::Context>, const V8Snapshot &,
+                             V8CodeCache *) {}
+
   void render(const string &view, const v8::Local<v8::Value> &parameters,
               Stream &stream) {
     auto ctx = context();
+    addSharedParameters(parameters);
 
     v8::Local<v8::Value> args[3];
     args[0] = V8Helper::newString(m_isolate, view);
@@ -137,7 +302,24 @@ V8Renderer::V8Renderer(const string &source)
 V8Renderer::V8Renderer(const string &source,
                        const std::vector<Prototype> &prototypes,
                        Object bindings)
-    : m_impl(make_unique<Impl>(source, prototypes, move(bindings))) {}
+    : V8Renderer(source, prototypes, move(bindings), nullptr) {}
+
+V8Renderer::V8Renderer(const string &source,
+                       const std::vector<Prototype> &prototypes,
+                       Object bindings, shared_ptr<V8CodeCache> codeCache)
+    : m_impl(make_unique<Impl>(source, prototypes, move(bindings),
+                               move(codeCache))) {}
+
+V8Renderer::V8Renderer(const V8Snapshot &snapshot)
+    : V8Renderer(snapshot, {}, {}) {}
+
+V8Renderer::V8Renderer(const V8Snapshot &snapshot,
+                       const std::vector<Prototype> &prototypes,
+                       Object bindings)
+    : m_impl(make_unique<Impl>(snapshot, prototypes, move(bindings),
+                               nullptr)) {}
+
+V8Renderer::V8Renderer(V8Renderer &&other) noexcept = default;
 
 V8Renderer::~V8Renderer() = default;
 
@@ -148,5 +330,46 @@ void V8Renderer::render(const string &view, const Object &parameters,
 
 void V8Renderer::render(const string &view, const string &parameters,
                         Stream &stream) {
+  m_impl->render(view, string_view(parameters), stream);
+}
+
+void V8Renderer::render(const string &view, string_view parameters,
+                        Stream &stream) {
+  m_impl->render(view, parameters, stream);
+}
+
+ParsedParameters V8Renderer::parse(string_view parameters) {
+  return m_impl->parse(parameters);
+}
+
+void V8Renderer::render(const string &view, const ParsedParameters &parameters,
+                        Stream &stream) {
   m_impl->render(view, parameters, stream);
 }
+
+string V8Renderer::renderToString(const string &view,
+                                  const ParsedParameters &parameters) {
+  auto stream = StringStream();
+  render(view, parameters, stream);
+  return stream.str();
+}
+
+void V8Renderer::setLazyMapping(bool enabled) {
+  m_impl->setLazyMapping(enabled);
+}
+
+void V8Renderer::setSharedParameter(const string &name, Value value) {
+  m_impl->setSharedParameter(name, move(value));
+}
+
+void V8Renderer::removeSharedParameter(const string &name) {
+  m_impl->removeSharedParameter(name);
+}
+
+void V8Renderer::setMemoCache(shared_ptr<MemoCache> cache) {
+  m_impl->setMemoCache(move(cache));
+}
+
+void V8Renderer::setHtmlEncode(bool enabled) {
+  m_impl->setHtmlEncode(enabled);
+}
@@ -15,6 +15,8 @@
 */
 #include "complate/v8/v8rendererbuilder.h"
 
+#include <mutex>
+
 using namespace std;
 using namespace complate;
 
@@ -23,13 +25,37 @@ public:
  void source(string sourceObj) {
    m_source = move(sourceObj);
    m_sourceCreator = {};
+   resetCreatedSnapshot();
  }
 
  void source(SourceCreator sourceCreator) {
    m_source = {};
    m_sourceCreator = move(sourceCreator);
+   resetCreatedSnapshot();
+ }
+
+ void snapshot(V8Snapshot snapshotObj) {
+   m_snapshot = make_shared<const V8Snapshot>(move(snapshotObj));
+ }
+
+ void createSnapshot(bool enabled) {
+   m_createdSnapshot = (enabled) ? make_shared<CreatedSnapshot>() : nullptr;
+ }
+
+ void codeCache(shared_ptr<V8CodeCache> cache) {
+   m_codeCache = move(cache);
+ }
+
+ void htmlEncode(bool enabled) { m_htmlEncode = enabled; }
+
+ void lazyMapping(bool enabled) { m_lazyMapping = enabled; }
+
+ void sharedParameters(Object parameters) {
+   m_sharedParameters = move(parameters);
  }
 
+ void memoCache(shared_ptr<MemoCache> cache) { m_memoCache = move(cache); }
+
  void bindings(Object bindingsObj) {
    m_bindings = move(bindingsObj);
    m_bindingsCreator = {};
@@ -51,34 +77,96 @@ public:
  }
 
  [[nodiscard]] V8Renderer build() const {
-   return {(m_sourceCreator) ? invoke(m_sourceCreator) : m_source,
-           (m_prototypesCreator) ? invoke(m_prototypesCreator) : m_prototypes,
-           (m_bindingsCreator) ? invoke(m_bindingsCreator) : m_bindings};
+   auto snapshotObj = makeSnapshot();
+   V8Renderer renderer =
+       (snapshotObj)
+           ? V8Renderer(*snapshotObj, makePrototypes(), makeBindings())
+           : V8Renderer(makeSource(), makePrototypes(), makeBindings(),
+                        m_codeCache);
+   configure(renderer);
+   return renderer;
  }
 
  [[nodiscard]] unique_ptr<V8Renderer> unique() const {
-   return make_unique<V8Renderer>(
-       (m_sourceCreator) ? invoke(m_sourceCreator) : m_source,
-       (m_prototypesCreator) ? invoke(m_prototypesCreator) : m_prototypes,
-       (m_bindingsCreator) ? invoke(m_bindingsCreator) : m_bindings);
+   auto snapshotObj = makeSnapshot();
+   auto renderer =
+       (snapshotObj) ? make_unique<V8Renderer>(*snapshotObj, makePrototypes(),
+                                               makeBindings())
+                     : make_unique<V8Renderer>(makeSource(), makePrototypes(),
+                                               makeBindings(), m_codeCache);
+   configure(*renderer);
+   return renderer;
  }
 
  [[nodiscard]] Renderer::Creator creator() const {
-   return [*this] {
-     return make_unique<V8Renderer>(
-         (m_sourceCreator) ? invoke(m_sourceCreator) : m_source,
-         (m_prototypesCreator) ? invoke(m_prototypesCreator) : m_prototypes,
-         (m_bindingsCreator) ? invoke(m_bindingsCreator) : m_bindings);
-   };
+   return [*this] { return unique(); };
  }
 
 private:
+ /** Snapshot created on first use, shared by all copies of this Impl */
+ struct CreatedSnapshot {
+   once_flag m_once;
+   shared_ptr<const V8Snapshot> m_snapshot;
+ };
+
  string m_source;
  SourceCreator m_sourceCreator;
  Object m_bindings;
  BindingsCreator m_bindingsCreator;
  vector<Prototype> m_prototypes;
  PrototypesCreator m_prototypesCreator;
+ bool m_htmlEncode = false;
+ bool m_lazyMapping = false;
+ Object m_sharedParameters;
+ shared_ptr<MemoCache> m_memoCache;
+ shared_ptr<const V8Snapshot> m_snapshot;
+ shared_ptr<CreatedSnapshot> m_createdSnapshot;
+ shared_ptr<V8CodeCache> m_codeCache;
+
+ void configure(V8Renderer &renderer) const {
+   renderer.setLazyMapping(m_lazyMapping);
+   for (const auto &[name, value] : m_sharedParameters) {
+     renderer.setSharedParameter(name, value);
+   }
+   if (m_memoCache) {
+     renderer.setMemoCache(m_memoCache);
+   }
+   if (m_htmlEncode) {
+     renderer.setHtmlEncode(true);
+   }
+ }
+
+ void resetCreatedSnapshot() {
+   if (m_createdSnapshot) {
+     m_createdSnapshot = make_shared<CreatedSnapshot>();
+   }
+ }
+
+ [[nodiscard]] string makeSource() const {
+   return (m_sourceCreator) ? invoke(m_sourceCreator) : m_source;
+ }
+
+ [[nodiscard]] vector<Prototype> makePrototypes() const {
+   return (m_prototypesCreator) ? invoke(m_prototypesCreator) : m_prototypes;
+ }
+
+ [[nodiscard]] Object makeBindings() const {
+   return (m_bindingsCreator) ? invoke(m_bindingsCreator) : m_bindings;
+ }
+
+ [[nodiscard]] shared_ptr<const V8Snapshot> makeSnapshot() const {
+   if (m_snapshot) {
+     return m_snapshot;
+   } else if (m_createdSnapshot) {
+     call_once(m_createdSnapshot->m_once, [this] {
+       m_createdSnapshot->m_snapshot =
+           make_shared<const V8Snapshot>(V8Snapshot::create(makeSource()));
+     });
+     return m_createdSnapshot->m_snapshot;
+   } else {
+     return nullptr;
+   }
+ }
 };
 
 V8RendererBuilder::V8RendererBuilder()
@@ -97,6 +185,42 @@ V8RendererBuilder &V8RendererBuilder::source(
  return *this;
 }
 
+V8RendererBuilder &V8RendererBuilder::snapshot(V8Snapshot snapshotObj) {
+  m_impl->snapshot(move(snapshotObj));
+  return *this;
+}
+
+V8RendererBuilder &V8RendererBuilder::createSnapshot(bool enabled) {
+  m_impl->createSnapshot(enabled);
+  return *this;
+}
+
+V8RendererBuilder &V8RendererBuilder::codeCache(
+    shared_ptr<V8CodeCache> cache) {
+  m_impl->codeCache(move(cache));
+  return *this;
+}
+
+V8RendererBuilder &V8RendererBuilder::htmlEncode(bool enabled) {
+  m_impl->htmlEncode(enabled);
+  return *this;
+}
+
+V8RendererBuilder &V8RendererBuilder::lazyMapping(bool enabled) {
+  m_impl->lazyMapping(enabled);
+  return *this;
+}
+
+V8RendererBuilder &V8RendererBuilder::sharedParameters(Object parameters) {
+  m_impl->sharedParameters(move(parameters));
+  return *this;
+}
+
+V8RendererBuilder &V8RendererBuilder::memoCache(shared_ptr<MemoCache> cache) {
+  m_impl->memoCache(move(cache));
+  return *this;
+}
+
 V8RendererBuilder &V8RendererBuilder::bindings(Object bindingsObj) {
   m_impl->bindings(move(bindingsObj));
  return *this;
@@ -0,0 +1,50 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/v8/v8snapshot.h>
+#include <v8.h>
+
+#include "v8helper.h"
+
+using namespace complate;
+using namespace std;
+
+V8Snapshot::V8Snapshot(vector<char> data)
+    : m_data(make_shared<const vector<char>>(move(data))) {}
+
+V8Snapshot V8Snapshot::create(const string &source) {
+  v8::StartupData blob{nullptr, 0};
+  {
+    v8::SnapshotCreator creator;
+    v8::Isolate *isolate = creator.GetIsolate();
+    {
+      v8::Isolate::Scope isolate_scope(isolate);
+      v8::HandleScope handle_scope(isolate);
+      v8::Local<v8::Context> ctx = v8::Context::New(isolate);
+      v8::Context::Scope context_scope(ctx);
+
+      V8Helper::evaluate(ctx, source);
+      creator.SetDefaultContext(ctx);
+    }
+    blob = creator.CreateBlob(
+        v8::SnapshotCreator::FunctionCodeHandling::kKeep);
+  }
+
+  vector<char> data(blob.data, blob.data + blob.raw_size);
+  delete[] blob.data;
+  return V8Snapshot(move(data));
+}
+
+const vector<char> &V8Snapshot::data() const { return *m_data; }
@@ -17,11 +17,13 @@
 
 using namespace complate;
 
+const char V8StreamAdapter::ms_tag = 0;
+
 V8StreamAdapter::V8StreamAdapter(v8::Isolate *isolate) : m_isolate(isolate) {
   v8::Locker locker(m_isolate);
   v8::HandleScope scope(m_isolate);
   auto tmpl = v8::ObjectTemplate::New(m_isolate);
-  tmpl->SetInternalFieldCount(1);
+  tmpl->SetInternalFieldCount(FIELD_COUNT);
 
   tmpl->Set(m_isolate, "write", v8::FunctionTemplate::New(m_isolate, write));
   tmpl->Set(m_isolate, "writeln",
@@ -34,10 +36,28 @@ v8::Local<v8::Object> V8StreamAdapter::adapterFor(Stream &stream) {
   auto adapter = m_template.Get(m_isolate)
                      ->NewInstance(m_isolate->GetCurrentContext())
                      .ToLocalChecked();
-  adapter->SetInternalField(0, v8::External::New(m_isolate, &stream));
+  adapter->SetInternalField(STREAM, v8::External::New(m_isolate, &stream));
+  adapter->SetInternalField(
+      TAG, v8::External::New(m_isolate, const_cast<char *>(&ms_tag)));
   return adapter;
 }
 
+Stream *V8StreamAdapter::streamOf(v8::Local<v8::Value> value) {
+  if (!value->IsObject()) {
+    return nullptr;
+  }
+  auto obj = value.As<v8::Object>();
+  if (obj->InternalFieldCount() != FIELD_COUNT) {
+    return nullptr;
+  }
+  auto tag = obj->GetInternalField(TAG);
+  if (!tag->IsExternal() || tag.As<v8::External>()->Value() != &ms_tag) {
+    return nullptr;
+  }
+  return static_cast<Stream *>(
+      obj->GetInternalField(STREAM).As<v8::External>()->Value());
+}
+
 void V8StreamAdapter::write(const v8::FunctionCallbackInfo<v8::Value> &args) {
   v8::Local<v8::String> str =
       args[0]
@@ -67,8 +87,9 @@ void V8StreamAdapter::flush(const v8::FunctionCallbackInfo<v8::Value> &args) {
 
 Stream *V8StreamAdapter::stream(
     const v8::FunctionCallbackInfo<v8::Value> &args) {
-  auto intern =
-      v8::Local<v8::External>::Cast(args.This()->GetInternalField(0))->Value();
+  auto intern = v8::Local<v8::External>::Cast(
+                    args.This()->GetInternalField(STREAM))
+                    ->Value();
   auto stream = static_cast<Stream *>(intern);
   return stream;
 }
@@ -26,8 +26,14 @@ public:
 
   v8::Local<v8::Object> adapterFor(Stream& stream);
 
+  /** The Stream of an adapter or nullptr, if the value isn't one */
+  static Stream* streamOf(v8::Local<v8::Value> value);
+
 private:
   static const std::size_t FAST_UTF8_BUFLEN = 2048;
+  enum Field { STREAM, TAG, FIELD_COUNT };
+  /** Its address tags adapters */
+  static const char ms_tag;
   v8::Isolate* m_isolate;
   v8::Persistent<v8::ObjectTemplate> m_template;
 
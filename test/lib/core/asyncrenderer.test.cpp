@@ -0,0 +1,188 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/asyncrenderer.h>
+#include <complate/core/exception.h>
+#include <complate/core/stringstream.h>
+
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "catch2/catch.hpp"
+#include "creatorspy.h"
+#include "noopstream.h"
+
+using namespace complate;
+using namespace std;
+using namespace std::chrono_literals;
+
+namespace {
+/** Renders the view name and the id of the rendering thread */
+class ThreadRenderer : public Renderer {
+public:
+  void render(const string &view, const Object &parameters,
+              Stream &stream) override {
+    if (view == "Throw") {
+      throw Exception("failed");
+    } else if (view == "Sleep") {
+      this_thread::sleep_for(300ms);
+    }
+    const string output = view + ":" + to_string(parameters.size());
+    stream.write(output.data(), (int)output.size());
+    lock_guard<mutex> guard(m_mutex);
+    m_threads.insert(this_thread::get_id());
+  }
+
+  void render(const string &view, const string &parameters,
+              Stream &stream) override {
+    render(view, Object{{"json", parameters}}, stream);
+  }
+
+  static mutex m_mutex;
+  static set<thread::id> m_threads;
+};
+mutex ThreadRenderer::m_mutex;
+set<thread::id> ThreadRenderer::m_threads;
+
+/** Counters are updated after the result has been passed */
+AsyncRenderer::Stats statsAfter(const AsyncRenderer &renderer,
+                                uint64_t executed) {
+  for (int i = 0; i < 100 && renderer.stats().executed < executed; ++i) {
+    this_thread::sleep_for(1ms);
+  }
+  return renderer.stats();
+}
+}  // namespace
+
+TEST_CASE("AsyncRenderer", "[core]") {
+  CreatorSpy creator([] { return make_unique<ThreadRenderer>(); });
+  AsyncRenderer::Options options;
+  options.threads = 2;
+
+  SECTION("create a renderer for every thread upon construction") {
+    AsyncRenderer renderer(creator, options);
+    REQUIRE(creator.callCount() == 2);
+    REQUIRE(renderer.threads() == 2);
+  }
+
+  SECTION("use the cores by default") {
+    AsyncRenderer renderer(creator);
+    REQUIRE(renderer.threads() >= 1);
+  }
+
+  SECTION("render to a future") {
+    AsyncRenderer renderer(creator, options);
+    future<string> object = renderer.renderAsync("View", Object{{"a", 1}});
+    future<string> json = renderer.renderAsync("View", "{}");
+    REQUIRE(object.get() == "View:1");
+    REQUIRE(json.get() == "View:1");
+  }
+
+  SECTION("render on worker threads") {
+    ThreadRenderer::m_threads.clear();
+    {
+      AsyncRenderer renderer(creator, options);
+      renderer.renderAsync("View", Object{}).get();
+    }
+    REQUIRE(ThreadRenderer::m_threads.count(this_thread::get_id()) == 0);
+  }
+
+  SECTION("pass exceptions with the future") {
+    AsyncRenderer renderer(creator, options);
+    future<string> result = renderer.renderAsync("Throw", Object{});
+    REQUIRE_THROWS_WITH(result.get(), "failed");
+  }
+
+  SECTION("render to a stream and call the completion") {
+    AsyncRenderer renderer(creator, options);
+    auto stream = StringStream();
+    promise<exception_ptr> done;
+    renderer.renderAsync("View", Object{}, stream,
+                         [&](exception_ptr e) { done.set_value(e); });
+    REQUIRE(done.get_future().get() == nullptr);
+    REQUIRE(stream.str() == "View:0");
+  }
+
+  SECTION("call the completion with the exception") {
+    AsyncRenderer renderer(creator, options);
+    auto stream = StringStream();
+    promise<exception_ptr> done;
+    renderer.renderAsync("Throw", "{}", stream,
+                         [&](exception_ptr e) { done.set_value(e); });
+    REQUIRE(done.get_future().get() != nullptr);
+  }
+
+  SECTION("render blocking") {
+    AsyncRenderer renderer(creator, options);
+    REQUIRE(renderer.renderToString("View", Object{}) == "View:0");
+    REQUIRE(renderer.renderToString("View", "{}") == "View:1");
+    REQUIRE_THROWS_AS(renderer.renderToString("Throw", Object{}),
+                      complate::Exception);
+  }
+
+  SECTION("steal renders queued behind a slow one") {
+    AsyncRenderer renderer(creator, options);
+    future<string> slow = renderer.renderAsync("Sleep", Object{});
+    future<string> first = renderer.renderAsync("View", Object{});
+    future<string> second = renderer.renderAsync("View", Object{});
+    REQUIRE(second.wait_for(200ms) == future_status::ready);
+    REQUIRE(slow.wait_for(0ms) == future_status::timeout);
+    slow.get();
+
+    const auto stats = statsAfter(renderer, 3);
+    REQUIRE(stats.stolen >= 1);
+    REQUIRE(stats.executed == 3);
+    REQUIRE(stats.queued == 0);
+    REQUIRE(stats.workers.size() == 2);
+    /* either worker may have picked up "Sleep" */
+    chrono::nanoseconds busy = 0ns;
+    for (const auto &worker : stats.workers) {
+      busy += worker.busy;
+      REQUIRE(worker.utilization >= 0);
+      REQUIRE(worker.utilization <= 1);
+    }
+    REQUIRE(busy >= 300ms);
+  }
+
+  SECTION("balance many renders over all workers") {
+    AsyncRenderer renderer(creator, options);
+    vector<future<string>> results;
+    for (int i = 0; i < 100; ++i) {
+      results.push_back(renderer.renderAsync("View", Object{}));
+    }
+    for (auto &result : results) {
+      REQUIRE(result.get() == "View:0");
+    }
+    const auto stats = statsAfter(renderer, 100);
+    REQUIRE(stats.executed == 100);
+    REQUIRE(stats.workers[0].executed + stats.workers[1].executed == 100);
+  }
+
+  SECTION("finish queued renders on destruction") {
+    atomic<int> completed = 0;
+    auto stream = NoopStream();
+    {
+      AsyncRenderer renderer(creator, options);
+      for (int i = 0; i < 50; ++i) {
+        renderer.renderAsync("View", Object{}, stream,
+                             [&](exception_ptr) { ++completed; });
+      }
+    }
+    REQUIRE(completed == 50);
+  }
+}
@@ -0,0 +1,132 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/bufferedstream.h>
+
+#include <string>
+#include <thread>
+
+#include "catch2/catch.hpp"
+
+using namespace Catch::Matchers;
+using namespace complate;
+using namespace std;
+using namespace std::chrono_literals;
+
+namespace {
+class RecordingStream : public Stream {
+public:
+  void write(const char *str, int len) override {
+    m_content.append(str, len);
+    ++m_writes;
+  }
+
+  void writeln(const char *str, int len) override {
+    write(str, len);
+    write("\n", 1);
+  }
+
+  void flush() override { ++m_flushes; }
+
+  string m_content;
+  int m_writes = 0;
+  int m_flushes = 0;
+};
+}  // namespace
+
+TEST_CASE("BufferedStream", "[core]") {
+  RecordingStream dest;
+  BufferedStream::Options options;
+  options.bufferSize = 16;
+  options.flushThreshold = 8;
+
+  SECTION("write") {
+    SECTION("coalesce small writes") {
+      BufferedStream stream(dest, options);
+      stream.write("abc", 3);
+      stream.write("def", 3);
+      REQUIRE(dest.m_writes == 0);
+      stream.drain();
+      REQUIRE_THAT(dest.m_content, Equals("abcdef"));
+      REQUIRE(dest.m_writes == 1);
+      REQUIRE(dest.m_flushes == 1);
+    }
+
+    SECTION("forward the buffer when it would be exceeded") {
+      BufferedStream stream(dest, options);
+      stream.write("0123456789", 10);
+      stream.write("0123456789", 10);
+      REQUIRE_THAT(dest.m_content, Equals("0123456789"));
+      REQUIRE(dest.m_flushes == 0);
+      stream.drain();
+      REQUIRE_THAT(dest.m_content, Equals("01234567890123456789"));
+    }
+
+    SECTION("write through strings larger than the buffer") {
+      BufferedStream stream(dest, options);
+      stream.write("abc", 3);
+      stream.write("0123456789abcdefghij", 20);
+      REQUIRE_THAT(dest.m_content, Equals("abc0123456789abcdefghij"));
+      REQUIRE(dest.m_writes == 2);
+    }
+  }
+
+  SECTION("writeln") {
+    SECTION("append a newline") {
+      BufferedStream stream(dest, options);
+      stream.writeln("abc", 3);
+      stream.drain();
+      REQUIRE_THAT(dest.m_content, Equals("abc\n"));
+      REQUIRE(dest.m_writes == 1);
+    }
+  }
+
+  SECTION("flush") {
+    SECTION("ignored below flushThreshold") {
+      BufferedStream stream(dest, options);
+      stream.write("abc", 3);
+      stream.flush();
+      REQUIRE(dest.m_writes == 0);
+      REQUIRE(dest.m_flushes == 0);
+    }
+
+    SECTION("honoured at flushThreshold") {
+      BufferedStream stream(dest, options);
+      stream.write("abcdefgh", 8);
+      stream.flush();
+      REQUIRE_THAT(dest.m_content, Equals("abcdefgh"));
+      REQUIRE(dest.m_flushes == 1);
+    }
+
+    SECTION("honoured when flushInterval elapsed") {
+      options.flushInterval = 1ms;
+      BufferedStream stream(dest, options);
+      stream.write("abc", 3);
+      this_thread::sleep_for(5ms);
+      stream.flush();
+      REQUIRE_THAT(dest.m_content, Equals("abc"));
+      REQUIRE(dest.m_flushes == 1);
+    }
+  }
+
+  SECTION("destructor forwards remaining output") {
+    {
+      BufferedStream stream(dest, options);
+      stream.write("abc", 3);
+    }
+    REQUIRE_THAT(dest.m_content, Equals("abc"));
+    REQUIRE(dest.m_flushes == 1);
+  }
+}
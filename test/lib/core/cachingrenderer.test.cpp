@@ -0,0 +1,195 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/cachingrenderer.h>
+#include <complate/core/exception.h>
+#include <complate/core/proxy.h>
+#include <complate/core/sharedvalue.h>
+#include <complate/core/stringstream.h>
+
+#include <atomic>
+#include <limits>
+#include <thread>
+
+#include "catch2/catch.hpp"
+
+using namespace complate;
+using namespace std;
+using namespace std::chrono_literals;
+
+namespace {
+class CountingRenderer : public Renderer {
+public:
+  explicit CountingRenderer(atomic<int> &count) : m_count(count) {}
+
+  void render(const string &view, const Object &parameters,
+              Stream &stream) override {
+    const string output = view + ":" + to_string(++m_count) + ":" +
+                          to_string(parameters.size());
+    stream.write(output.data(), (int)output.size());
+  }
+
+  void render(const string &view, const string &parameters,
+              Stream &stream) override {
+    const string output =
+        view + ":" + to_string(++m_count) + ":" + parameters;
+    stream.writeln(output.data(), (int)output.size());
+  }
+
+private:
+  atomic<int> &m_count;
+};
+}  // namespace
+
+TEST_CASE("CachingRenderer", "[core]") {
+  atomic<int> count = 0;
+  auto creator = [&count] { return make_unique<CountingRenderer>(count); };
+
+  SECTION("serve equal Object parameters from the cache") {
+    CachingRenderer renderer(creator);
+    const Object parameters{{"a", Array{1, "x"}}, {"b", Object{{"c", true}}}};
+    REQUIRE(renderer.renderToString("View", parameters) == "View:1:2");
+    REQUIRE(renderer.renderToString("View", parameters) == "View:1:2");
+    REQUIRE(renderer.renderToString("Other", parameters) == "Other:2:2");
+    REQUIRE(renderer.renderToString("View", Object{{"a", 2}}) == "View:3:1");
+    REQUIRE(renderer.stats().hits == 1);
+    REQUIRE(renderer.stats().misses == 3);
+    REQUIRE(renderer.stats().entries == 3);
+  }
+
+  SECTION("keep Object parameters apart which JSON can't tell apart") {
+    CachingRenderer renderer(creator);
+    const vector<Object> parameters{
+        Object{{"a", numeric_limits<double>::quiet_NaN()}},
+        Object{{"a", numeric_limits<double>::infinity()}},
+        Object{{"a", nullptr}},
+        Object{{"a", Value()}},
+        Object{},
+        Object{{"a", Array{Value()}}},
+        Object{{"a", Array{nullptr}}},
+        Object{{"a", 0.0}},
+        Object{{"a", -0.0}},
+        Object{{"a", "1"}},
+        Object{{"a", Object{{"b", "1"}}}},
+        Object{{"a", SharedValue(Object{{"b", "1"}})}}};
+    vector<string> outputs;
+    for (const auto &p : parameters) {
+      outputs.push_back(renderer.renderToString("View", p));
+    }
+    for (size_t i = 0; i < parameters.size(); ++i) {
+      REQUIRE(renderer.renderToString("View", parameters[i]) == outputs[i]);
+    }
+    REQUIRE(renderer.stats().misses == parameters.size());
+    REQUIRE(renderer.stats().hits == parameters.size());
+  }
+
+  SECTION("serve equal JSON parameters from the cache") {
+    CachingRenderer renderer(creator);
+    REQUIRE(renderer.renderToString("View", "{}") == "View:1:{}\n");
+    REQUIRE(renderer.renderToString("View", "{}") == "View:1:{}\n");
+    REQUIRE(renderer.renderToString("View", "{ }") == "View:2:{ }\n");
+  }
+
+  SECTION("write the cached output in one call") {
+    CachingRenderer renderer(creator);
+    auto stream = StringStream();
+    renderer.render("View", Object{}, stream);
+    renderer.render("View", Object{}, stream);
+    REQUIRE(stream.str() == "View:1:0View:1:0");
+  }
+
+  SECTION("don't cache parameters holding a Proxy") {
+    CachingRenderer renderer(creator);
+    const Object parameters{{"p", Array{Proxy("P", make_shared<int>(1))}}};
+    renderer.renderToString("View", parameters);
+    REQUIRE(renderer.renderToString("View", parameters) == "View:2:1");
+    REQUIRE(renderer.stats().entries == 0);
+  }
+
+  SECTION("evict the least recently used output") {
+    CachingRenderer::Options options;
+    options.shards = 1;
+    options.maxBytes = 40;
+    CachingRenderer renderer(creator, options);
+    renderer.renderToString("A", Object{});
+    renderer.renderToString("B", Object{});
+    renderer.renderToString("A", Object{});
+    renderer.renderToString("C", Object{});
+    REQUIRE(renderer.stats().evicted == 1);
+    REQUIRE(renderer.renderToString("A", Object{}) == "A:1:0");
+    REQUIRE(renderer.renderToString("B", Object{}) == "B:4:0");
+    REQUIRE(renderer.stats().bytes <= options.maxBytes);
+  }
+
+  SECTION("don't cache output larger than a shard") {
+    CachingRenderer::Options options;
+    options.shards = 1;
+    options.maxBytes = 4;
+    CachingRenderer renderer(creator, options);
+    renderer.renderToString("View", Object{});
+    REQUIRE(renderer.renderToString("View", Object{}) == "View:2:0");
+  }
+
+  SECTION("drop output after the ttl") {
+    CachingRenderer::Options options;
+    options.ttl = 20ms;
+    CachingRenderer renderer(creator, options);
+    renderer.renderToString("View", Object{});
+    this_thread::sleep_for(30ms);
+    REQUIRE(renderer.renderToString("View", Object{}) == "View:2:0");
+    REQUIRE(renderer.stats().expired == 1);
+  }
+
+  SECTION("drop all output on clear") {
+    CachingRenderer renderer(creator);
+    renderer.renderToString("View", Object{});
+    renderer.clear();
+    REQUIRE(renderer.stats().entries == 0);
+    REQUIRE(renderer.stats().bytes == 0);
+    REQUIRE(renderer.renderToString("View", Object{}) == "View:2:0");
+  }
+
+  SECTION("don't cache output of failed renders") {
+    class ThrowingRenderer : public CountingRenderer {
+    public:
+      using CountingRenderer::CountingRenderer;
+      using CountingRenderer::render;
+      void render(const string &, const Object &, Stream &) override {
+        throw Exception("failed");
+      }
+    };
+    CachingRenderer renderer(
+        [&count] { return make_unique<ThrowingRenderer>(count); });
+    REQUIRE_THROWS(renderer.renderToString("View", Object{}));
+    REQUIRE(renderer.stats().entries == 0);
+  }
+
+  SECTION("can be used concurrently") {
+    CachingRenderer renderer(creator);
+    vector<thread> threads;
+    for (int i = 0; i < 4; ++i) {
+      threads.emplace_back([&renderer] {
+        for (int j = 0; j < 100; ++j) {
+          renderer.renderToString("View", Object{{"j", j % 10}});
+        }
+      });
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+    REQUIRE(renderer.stats().entries == 10);
+    REQUIRE(renderer.stats().hits + renderer.stats().misses == 400);
+  }
+}
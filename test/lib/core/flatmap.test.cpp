@@ -0,0 +1,99 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/flatmap.h>
+#include <complate/core/value.h>
+
+#include <string>
+#include <type_traits>
+
+#include "catch2/catch.hpp"
+
+using namespace complate;
+using namespace std;
+
+TEST_CASE("FlatMap", "[core]") {
+  FlatMap<string, int> map{{"b", 2}, {"a", 1}, {"c", 3}, {"a", 4}};
+
+  SECTION("keep entries sorted by key") {
+    REQUIRE(map.size() == 3);
+    string keys;
+    for (const auto &[k, v] : map) {
+      keys += k + to_string(v);
+    }
+    REQUIRE(keys == "a1b2c3");
+  }
+
+  SECTION("find entries") {
+    REQUIRE(map.find("b")->second == 2);
+    REQUIRE(map.find(string_view("c"))->second == 3);
+    REQUIRE(map.find("d") == map.cend());
+    REQUIRE(map.count("a") == 1);
+    REQUIRE(map.count("z") == 0);
+    REQUIRE(map.at("a") == 1);
+    REQUIRE_THROWS_AS(map.at("z"), out_of_range);
+  }
+
+  SECTION("emplace like std::map") {
+    REQUIRE(map.emplace("aa", 5).second);
+    REQUIRE(map.emplace("d", 6).second);
+    REQUIRE_FALSE(map.emplace("b", 7).second);
+    REQUIRE(map.at("b") == 2);
+    REQUIRE(map == FlatMap<string, int>{
+                       {"a", 1}, {"aa", 5}, {"b", 2}, {"c", 3}, {"d", 6}});
+  }
+
+  SECTION("assign and erase") {
+    map["z"] = 26;
+    map["a"] = 0;
+    REQUIRE(map.insert_or_assign("b", 9).second == false);
+    REQUIRE(map.erase("c") == 1);
+    REQUIRE(map.erase("c") == 0);
+    REQUIRE(map == FlatMap<string, int>{{"a", 0}, {"b", 9}, {"z", 26}});
+  }
+
+  SECTION("erase by iterator like std::map") {
+    auto next = map.erase(map.find("b"));
+    REQUIRE(next->first == "c");
+    REQUIRE(map.erase(map.cbegin())->first == "c");
+    REQUIRE(map.erase(string("c")) == 1);
+    REQUIRE(map.empty());
+  }
+
+  SECTION("expose keys as const") {
+    using Reference = decltype(*map.begin());
+    STATIC_REQUIRE(is_same_v<Reference, pair<const string &, int &>>);
+    STATIC_REQUIRE_FALSE(is_assignable_v<decltype((map.begin()->first)),
+                                         string>);
+    STATIC_REQUIRE(is_same_v<FlatMap<string, int>::value_type,
+                             pair<const string, int>>);
+    map.begin()->second = 10;
+    for (auto [k, v] : map) {
+      v += 1;
+    }
+    REQUIRE(map == FlatMap<string, int>{{"a", 11}, {"b", 3}, {"c", 4}});
+    FlatMap<string, int>::const_iterator it = map.begin();
+    REQUIRE(it == map.begin());
+    REQUIRE(map.end() - it == 3);
+  }
+
+  SECTION("hold Values recursively") {
+    FlatMap<string, Value> obj{{"list", Array{Object{{"name", "Klaus"}}}},
+                               {"age", 23}};
+    REQUIRE(obj.begin()->first == "age");
+    const auto &list = obj.at("list").exactly<Array>();
+    REQUIRE(list.at(0).exactly<Object>().at("name") == "Klaus");
+  }
+}
@@ -0,0 +1,67 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/htmlencode.h>
+
+#include "catch2/catch.hpp"
+
+using namespace Catch::Matchers;
+using namespace complate;
+using namespace std;
+
+TEST_CASE("HtmlEncode", "[core]") {
+  SECTION("find") {
+    SECTION("return npos when there is nothing to escape") {
+      REQUIRE(HtmlEncode::find("") == string_view::npos);
+      REQUIRE(HtmlEncode::find("a longer text without specials 'x'") ==
+              string_view::npos);
+    }
+
+    SECTION("find the first special character at every position") {
+      for (size_t i = 0; i < 40; ++i) {
+        string str(40, 'a');
+        str[i] = '>';
+        REQUIRE(HtmlEncode::find(str) == i);
+      }
+    }
+
+    SECTION("find quotes only within attributes") {
+      const string str = "0123456789abcdef\"quoted\"";
+      REQUIRE(HtmlEncode::find(str) == string_view::npos);
+      REQUIRE(HtmlEncode::find(str, true) == 16);
+    }
+  }
+
+  SECTION("encode") {
+    SECTION("escape like complate-stream") {
+      REQUIRE_THAT(HtmlEncode::encode("<a href='x'>Tom & \"Jerry\"</a>"),
+                   Equals("&lt;a href='x'&gt;Tom &amp; \"Jerry\"&lt;/a&gt;"));
+      REQUIRE_THAT(
+          HtmlEncode::encode("<a href='x'>Tom & \"Jerry\"</a>", true),
+          Equals("&lt;a href=&#x27;x&#x27;&gt;Tom &amp; &quot;Jerry&quot;"
+                 "&lt;/a&gt;"));
+    }
+
+    SECTION("return the input when there is nothing to escape") {
+      REQUIRE_THAT(HtmlEncode::encode("nothing to escape"),
+                   Equals("nothing to escape"));
+    }
+
+    SECTION("escape characters beyond the first 16 bytes") {
+      REQUIRE_THAT(HtmlEncode::encode("0123456789abcdef0123<>"),
+                   Equals("0123456789abcdef0123&lt;&gt;"));
+    }
+  }
+}
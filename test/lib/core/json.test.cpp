@@ -0,0 +1,167 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/exception.h>
+#include <complate/core/json.h>
+#include <complate/core/sharedvalue.h>
+
+#include <clocale>
+#include <cmath>
+#include <limits>
+
+#include "catch2/catch.hpp"
+
+using namespace complate;
+using namespace std;
+
+TEST_CASE("Json", "[core]") {
+  SECTION("parse all types") {
+    const Value value = Json::parse(
+        R"( {"n": null, "t": true, "f": false, "s": "str", "a": [1, [2]],)"
+        R"( "o": {"k": "v"}} )");
+    const auto &object = value.get<Object>();
+    REQUIRE(object.at("n").holds<Null>());
+    REQUIRE(object.at("t") == true);
+    REQUIRE(object.at("f") == false);
+    REQUIRE(object.at("s") == "str");
+    REQUIRE(object.at("a") == Array{1, Array{2}});
+    REQUIRE(object.at("o") == Object{{"k", "v"}});
+  }
+
+  SECTION("parse numbers like JSON.parse") {
+    const auto number = [](const char *json) {
+      return Json::parse(json).get<Number>();
+    };
+    REQUIRE(number("42").exactly<int32_t>() == 42);
+    REQUIRE(number("-2147483648").exactly<int32_t>() == -2147483648LL);
+    REQUIRE(number("2147483648").exactly<double>() == 2147483648.0);
+    REQUIRE(number("12345678901234").exactly<double>() == 12345678901234.0);
+    REQUIRE(number("1.5").exactly<double>() == 1.5);
+    REQUIRE(number("-2.5e3").exactly<double>() == -2500.0);
+    REQUIRE(signbit(number("-0").exactly<double>()));
+  }
+
+  SECTION("let the last of duplicate keys win") {
+    REQUIRE(Json::parse(R"({"a": 1, "a": 2})") == Object{{"a", 2}});
+  }
+
+  SECTION("decode escape sequences") {
+    REQUIRE(Json::parse(R"("a\"b\\c\/d\n\t")") == "a\"b\\c/d\n\t");
+    REQUIRE(Json::parse(R"("\u00e4\u20ac")") == "\xc3\xa4\xe2\x82\xac");
+    REQUIRE(Json::parse(R"("\ud83d\ude00")") == "\xf0\x9f\x98\x80");
+    REQUIRE(Json::parse(R"("\ud83d")") == "\xef\xbf\xbd");
+  }
+
+  SECTION("find escapes in long strings") {
+    const string text(40, 'x');
+    REQUIRE(Json::parse("\"" + text + "\\n" + text + "\"") ==
+            text + "\n" + text);
+  }
+
+  SECTION("reference the JSON text with parseView") {
+    const string json = R"(["plain", "esc\"aped"])";
+    const Value value = Json::parseView(json);
+    const auto &array = value.get<Array>();
+    REQUIRE(array[0].get<String>().holds<string_view>());
+    REQUIRE(array[0].get<String>().get<string_view>().data() ==
+            json.data() + 2);
+    REQUIRE(array[1].get<String>().holds<string>());
+    REQUIRE(array[1] == "esc\"aped");
+  }
+
+  SECTION("copy strings with parse") {
+    const Value value = Json::parse(R"("plain")");
+    REQUIRE(value.get<String>().holds<string>());
+  }
+
+  SECTION("throw on malformed JSON") {
+    REQUIRE_THROWS_AS(Json::parse(""), Exception);
+    REQUIRE_THROWS_AS(Json::parse("{"), Exception);
+    REQUIRE_THROWS_AS(Json::parse("[1,]"), Exception);
+    REQUIRE_THROWS_AS(Json::parse("{'a': 1}"), Exception);
+    REQUIRE_THROWS_AS(Json::parse("01"), Exception);
+    REQUIRE_THROWS_AS(Json::parse("1."), Exception);
+    REQUIRE_THROWS_AS(Json::parse("\"a\nb\""), Exception);
+    REQUIRE_THROWS_AS(Json::parse("\"\\x\""), Exception);
+    REQUIRE_THROWS_AS(Json::parse("tru"), Exception);
+    REQUIRE_THROWS_AS(Json::parse("[] []"), Exception);
+    REQUIRE_THROWS_AS(Json::parse(string(1000, '[')), Exception);
+    REQUIRE_THROWS_WITH(
+        Json::parse("[1, x]"),
+        "SyntaxError: Unexpected token 'x' in JSON at position 4");
+  }
+
+  SECTION("stringify all types") {
+    const Value value = Object{{"a", Array{1, 2.5, true, nullptr}},
+                               {"s", "q\"\\\n\x01"},
+                               {"u", Value()}};
+    REQUIRE(Json::stringify(value) ==
+            R"({"a":[1,2.5,true,null],"s":"q\"\\\n\u0001"})");
+  }
+
+  SECTION("stringify numbers") {
+    REQUIRE(Json::stringify(Value(int64_t(1) << 40)) == "1099511627776");
+    REQUIRE(Json::stringify(Value(numeric_limits<uint32_t>::max())) ==
+            "4294967295");
+    REQUIRE(Json::stringify(Value(0.1)) == "0.1");
+    REQUIRE(Json::stringify(Value(numeric_limits<double>::infinity())) ==
+            "null");
+    const double third = 1.0 / 3.0;
+    REQUIRE(Json::parse(Json::stringify(Value(third))) == third);
+  }
+
+  SECTION("write null for unrepresentable values outside objects") {
+    REQUIRE(Json::stringify(Array{Value(), Function()}) ==
+            "[null,null]");
+    REQUIRE(Json::stringify(Value()) == "null");
+  }
+
+  SECTION("stringify shared values") {
+    const SharedValue shared(Object{{"k", Value()}, {"v", 1}});
+    REQUIRE(Json::stringify(Object{{"s", shared}}) == R"({"s":{"v":1}})");
+  }
+
+  SECTION("round trip") {
+    const string json =
+        R"({"a":[1,-2,3.25,"x\ty"],"b":{"c":null,"d":false},"e":""})";
+    REQUIRE(Json::stringify(Json::parse(json)) == json);
+  }
+
+  SECTION("append to a string") {
+    string out = "json=";
+    Json::stringify(Array{1}, out);
+    REQUIRE(out == "json=[1]");
+  }
+
+  SECTION("ignore the decimal point of the locale") {
+    const string previous = setlocale(LC_NUMERIC, nullptr);
+    const char *locale = nullptr;
+    for (const char *name : {"de_DE.UTF-8", "de_DE.utf8", "de_DE", "German"}) {
+      if ((locale = setlocale(LC_NUMERIC, name)) != nullptr) {
+        break;
+      }
+    }
+    if (locale == nullptr) {
+      WARN("no locale with a decimal comma is installed");
+      return;
+    }
+
+    const Value parsed = Json::parse("[1.5, 2.5e3, 0.1]");
+    const string stringified = Json::stringify(Array{1.5, 0.1, 1.0 / 3.0});
+    setlocale(LC_NUMERIC, previous.c_str());
+    REQUIRE(parsed == Array{1.5, 2500.0, 0.1});
+    REQUIRE(stringified == "[1.5,0.1,0.33333333333333331]");
+  }
+}
@@ -0,0 +1,84 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/memocache.h>
+
+#include "catch2/catch.hpp"
+
+using namespace complate;
+using namespace std;
+
+TEST_CASE("MemoCache", "[core]") {
+  MemoCache cache(32);
+
+  SECTION("store and get html by key") {
+    REQUIRE(cache.get("footer") == nullptr);
+    REQUIRE(cache.put("footer", "<footer/>"));
+    REQUIRE(*cache.get("footer") == "<footer/>");
+    REQUIRE(cache.size() == 1);
+    REQUIRE(cache.bytes() == 15);
+  }
+
+  SECTION("replace html of a key") {
+    cache.put("footer", "<footer/>");
+    cache.put("footer", "<p/>");
+    REQUIRE(*cache.get("footer") == "<p/>");
+    REQUIRE(cache.bytes() == 10);
+  }
+
+  SECTION("don't store html exceeding maxBytes on it's own") {
+    REQUIRE(cache.put("a", string(20, 'x')));
+    REQUIRE_FALSE(cache.put("b", string(32, 'x')));
+    REQUIRE(cache.get("b") == nullptr);
+    REQUIRE(cache.get("a") != nullptr);
+    REQUIRE(cache.put("a", string(31, 'x')));
+  }
+
+  SECTION("drop the least recently used html to stay below maxBytes") {
+    REQUIRE(cache.put("a", string(14, 'a')));
+    REQUIRE(cache.put("b", string(14, 'b')));
+    REQUIRE(cache.get("a") != nullptr);
+    REQUIRE(cache.put("c", string(14, 'c')));
+    REQUIRE(cache.get("b") == nullptr);
+    REQUIRE(*cache.get("a") == string(14, 'a'));
+    REQUIRE(*cache.get("c") == string(14, 'c'));
+    REQUIRE(cache.size() == 2);
+    REQUIRE(cache.bytes() == 30);
+
+    for (char key = 'd'; key <= 'z'; ++key) {
+      REQUIRE(cache.put(string(1, key), "html"));
+    }
+    REQUIRE(*cache.get("z") == "html");
+    REQUIRE(cache.bytes() <= 32);
+  }
+
+  SECTION("invalidate keys") {
+    cache.put("a", "1");
+    cache.put("b", "2");
+    cache.invalidate("a");
+    REQUIRE(cache.get("a") == nullptr);
+    REQUIRE(cache.size() == 1);
+    cache.clear();
+    REQUIRE(cache.size() == 0);
+    REQUIRE(cache.bytes() == 0);
+  }
+
+  SECTION("keep returned html valid after invalidation") {
+    cache.put("a", "html");
+    auto html = cache.get("a");
+    cache.clear();
+    REQUIRE(*html == "html");
+  }
+}
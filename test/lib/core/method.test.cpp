@@ -64,6 +64,39 @@ TEST_CASE("Method", "[core]") {
     REQUIRE(testClass.args() == args);
   }
 
+  SECTION("typed args") {
+    Method method("add", &PrototypeTestClass::add);
+    REQUIRE(method.typed());
+    REQUIRE(method.apply(&testClass, {21, true}) == 42);
+    REQUIRE(method.apply(&testClass, {21}) == 21);
+  }
+
+  SECTION("typed string_view args and return") {
+    Method prefixed("prefixed", &PrototypeTestClass::prefixed);
+    Method strView("strView", &PrototypeTestClass::strView);
+    REQUIRE(prefixed.apply(&testClass, {"say "}) == "say foobar");
+    REQUIRE(strView.apply(&testClass, {}) == "foobar");
+  }
+
+  SECTION("invoke with a NativeCall") {
+    Method typed("add", &PrototypeTestClass::add);
+    Method untyped("strReturnWithArgs", &PrototypeTestClass::strReturnWithArgs);
+    REQUIRE_FALSE(untyped.typed());
+    Array args = {2, true};
+    ValueCall typedCall(args);
+    typed.invoke(&testClass, typedCall);
+    REQUIRE(typedCall.value() == 4);
+    ValueCall untypedCall(args);
+    untyped.invoke(&testClass, untypedCall);
+    REQUIRE(untypedCall.value() == "foobar");
+    REQUIRE(testClass.args() == args);
+  }
+
+  SECTION("typed returns undefined for nullptr") {
+    Method method("add", &PrototypeTestClass::add);
+    REQUIRE(method.apply(nullptr, {1, true}) == Value());
+  }
+
   SECTION("name") {
     Method method("noReturnNoArgs", &PrototypeTestClass::noReturnNoArgs);
     REQUIRE(method.name() == "noReturnNoArgs");
@@ -0,0 +1,153 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/nativecall.h>
+
+#include <cmath>
+
+#include "catch2/catch.hpp"
+
+using namespace complate;
+using namespace std;
+
+namespace {
+class Calculator {
+public:
+  [[nodiscard]] double scale(double value, int32_t factor) const {
+    return value * factor;
+  }
+
+  [[nodiscard]] uint64_t size(const string &text) const { return text.size(); }
+
+  [[nodiscard]] const char *name() const { return m_name; }
+
+  void rename(const char *name) { m_name = name; }
+
+  void reset(bool) { m_name = "calculator"; }
+
+  [[nodiscard]] Value echo(const Value &value) const { return value; }
+
+  [[nodiscard]] Array wrap(const Array &array) const { return {array}; }
+
+private:
+  const char *m_name = "calculator";
+};
+
+/** ValueCall whose integer conversion throws, like a failing valueOf() */
+class ThrowingCall : public ValueCall {
+public:
+  using ValueCall::ValueCall;
+
+  [[nodiscard]] bool failed() const override { return m_failed; }
+
+  [[nodiscard]] int32_t toInt32(int) override {
+    m_failed = true;
+    return 0;
+  }
+
+private:
+  bool m_failed = false;
+};
+}  // namespace
+
+TEST_CASE("NativeCall", "[core]") {
+  Calculator calculator;
+
+  SECTION("convert arguments and result") {
+    auto invoker = NativeCall::bind(&Calculator::scale);
+    Array args = {1.5, 4};
+    ValueCall call(args);
+    invoker(&calculator, call);
+    REQUIRE(call.value() == 6.0);
+  }
+
+  SECTION("missing arguments are converted from undefined") {
+    auto invoker = NativeCall::bind(&Calculator::scale);
+    Array args = {1.5};
+    ValueCall call(args);
+    invoker(&calculator, call);
+    REQUIRE(call.value() == 0.0);
+
+    Array noArgs;
+    ValueCall empty(noArgs);
+    invoker(&calculator, empty);
+    REQUIRE(std::isnan(empty.value().get<double>()));
+  }
+
+  SECTION("return 64 bit integers") {
+    auto invoker = NativeCall::bind(&Calculator::size);
+    Array args = {"four"};
+    ValueCall call(args);
+    invoker(&calculator, call);
+    REQUIRE(call.value() == int64_t(4));
+  }
+
+  SECTION("return const char * as string") {
+    auto invoker = NativeCall::bind(&Calculator::name);
+    Array args;
+    ValueCall call(args);
+    invoker(&calculator, call);
+    REQUIRE(call.value() == "calculator");
+
+    calculator.rename(nullptr);
+    invoker(&calculator, call);
+    REQUIRE(call.value() == nullptr);
+  }
+
+  SECTION("return undefined for void") {
+    auto invoker = NativeCall::bind(&Calculator::reset);
+    Array args = {true};
+    ValueCall call(args);
+    call.returnNull();
+    invoker(&calculator, call);
+    REQUIRE(call.value() == Value());
+  }
+
+  SECTION("pass and return Value and other types of a Value") {
+    Array args = {Array{1, 2}};
+    ValueCall echo(args);
+    NativeCall::bind(&Calculator::echo)(&calculator, echo);
+    REQUIRE(echo.value() == Array{1, 2});
+
+    ValueCall wrap(args);
+    NativeCall::bind(&Calculator::wrap)(&calculator, wrap);
+    REQUIRE(wrap.value() == Array{Array{1, 2}});
+  }
+
+  SECTION("bind a function taking the object as reference") {
+    auto invoker = NativeCall::bind(std::function<string(Calculator &, bool)>(
+        [](Calculator &c, bool upper) { return upper ? "CALC" : c.name(); }));
+    Array args = {true};
+    ValueCall call(args);
+    invoker(&calculator, call);
+    REQUIRE(call.value() == "CALC");
+  }
+
+  SECTION("do not call the function if a conversion failed") {
+    bool called = false;
+    auto invoker = NativeCall::bind(std::function<int(Calculator &, int32_t)>(
+        [&called](Calculator &, int32_t value) {
+          called = true;
+          return value;
+        }));
+    Array args = {1};
+    ThrowingCall call(args);
+    call.returnNull();
+    invoker(&calculator, call);
+    REQUIRE(call.failed());
+    REQUIRE_FALSE(called);
+    REQUIRE(call.value() == nullptr);
+  }
+}
@@ -73,6 +73,25 @@ TEST_CASE("Property", "[core]") {
     REQUIRE(property.get(&testClass) == "baz");
   }
 
+  SECTION("constructed with typed getter") {
+    Property property("prop", &PrototypeTestClass::strView);
+    REQUIRE(property.typed());
+    REQUIRE(property.get(&testClass) == "foobar");
+    Array args;
+    ValueCall call(args);
+    property.invoke(&testClass, call);
+    REQUIRE(call.value() == "foobar");
+  }
+
+  SECTION("not pure by default") {
+    Property property("prop", &PrototypeTestClass::strReturnNoArgs);
+    REQUIRE_FALSE(property.pure());
+    property.setPure(true);
+    REQUIRE(property.pure());
+    Property copy = property;  // NOLINT - I want to copy to test copy
+    REQUIRE(copy.pure());
+  }
+
   SECTION("name") {
     Property property("prop", &PrototypeTestClass::strReturnNoArgs);
     REQUIRE(property.name() == "prop");
@@ -68,6 +68,14 @@ TEST_CASE("Prototype", "[core]") {
     REQUIRE(property.name() == "strReturnNoArgs");
   }
 
+  SECTION("snapshot is disabled by default and copied") {
+    Prototype prototype("PrototypeTestClass");
+    REQUIRE_FALSE(prototype.snapshot());
+    prototype.setSnapshot(true);
+    Prototype copy = prototype;  // NOLINT - I need copy for testing
+    REQUIRE(copy.snapshot());
+  }
+
   SECTION("get a property") {
     Prototype prototype("PrototypeTestClass");
     prototype.addProperty(
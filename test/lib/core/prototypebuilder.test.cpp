@@ -13,6 +13,7 @@
  *  See the License for the specific language governing permissions and
  *  limitations under the License.
  */
+#include <complate/core/exception.h>
 #include <complate/core/prototypebuilder.h>
 
 #include "catch2/catch.hpp"
@@ -66,6 +67,21 @@ TEST_CASE("PrototypeBuilder", "[core]") {
                           })
           .build();
 
+  SECTION("pure property") {
+    auto proto = PrototypeBuilder<PrototypeTestClass>("PrototypeTestClass")
+                     .property("readonly", &PrototypeTestClass::strReturnNoArgs)
+                     .property("other", &PrototypeTestClass::strReturnNoArgs)
+                     .pure("readonly")
+                     .build();
+    REQUIRE(proto.property("readonly")->pure());
+    REQUIRE_FALSE(proto.property("other")->pure());
+  }
+
+  SECTION("pure of unknown property throws") {
+    PrototypeBuilder<PrototypeTestClass> builder("PrototypeTestClass");
+    REQUIRE_THROWS_AS(builder.pure("unknown"), Exception);
+  }
+
   SECTION("constructed without name, take typeid for name") {
     auto proto =
         PrototypeBuilder<PrototypeTestClass>().build();
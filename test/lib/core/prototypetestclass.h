@@ -16,6 +16,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 #include <utility>
 
 class PrototypeTestClass {
@@ -46,6 +47,16 @@ public:
     return m_returnString;
   }
 
+  [[nodiscard]] int add(int value, bool twice) const {
+    return twice ? 2 * value : value;
+  }
+
+  [[nodiscard]] std::string_view strView() const { return m_returnString; }
+
+  std::string prefixed(std::string_view prefix) {
+    return std::string(prefix) + m_returnString;
+  }
+
   [[nodiscard]] int cntNoReturnNoArgsCalled() const {
     return m_cntNoReturnNoArgsCalled;
   }
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/renderarena.h>
+#include <complate/core/value.h>
+
+#include <cstdint>
+
+#include "catch2/catch.hpp"
+
+using namespace complate;
+using namespace std;
+
+TEST_CASE("RenderArena", "[core]") {
+  RenderArena arena(64);
+
+  SECTION("copy strings") {
+    string text = "Hello arena";
+    Value value = arena.string(text);
+    text = "changed";
+    REQUIRE(value.exactly<String>().holds<string_view>());
+    REQUIRE(value.get<string>() == "Hello arena");
+    REQUIRE(arena.copy("").empty());
+  }
+
+  SECTION("align allocations") {
+    arena.allocate(1, 1);
+    auto ptr = reinterpret_cast<uintptr_t>(arena.allocate(8, 8));
+    REQUIRE(ptr % 8 == 0);
+    REQUIRE(arena.used() == 9);
+  }
+
+  SECTION("serve large allocations from a block of their own") {
+    arena.allocate(16);
+    arena.allocate(1000);
+    REQUIRE(arena.capacity() >= 1064);
+  }
+
+  SECTION("reuse blocks after reset") {
+    auto first = arena.copy("first");
+    arena.allocate(200);
+    const size_t capacity = arena.capacity();
+    arena.reset();
+    REQUIRE(arena.used() == 0);
+    auto again = arena.copy("again");
+    REQUIRE(again.data() == first.data());
+    arena.allocate(200);
+    REQUIRE(arena.capacity() == capacity);
+  }
+}
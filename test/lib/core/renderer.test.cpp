@@ -0,0 +1,57 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/renderer.h>
+#include <complate/core/stringstream.h>
+
+#include "catch2/catch.hpp"
+
+using namespace complate;
+using namespace std;
+
+namespace {
+/** Overrides only the pure virtual methods, like Renderer's out there */
+class EchoRenderer : public Renderer {
+public:
+  void render(const string &view, const Object &, Stream &stream) override {
+    stream.write(view.data(), (int)view.size());
+  }
+
+  void render(const string &view, const string &parameters,
+              Stream &stream) override {
+    const string output = view + ":" + parameters;
+    stream.write(output.data(), (int)output.size());
+  }
+};
+}  // namespace
+
+TEST_CASE("Renderer", "[core]") {
+  EchoRenderer renderer;
+
+  SECTION("render JSON of any string type with the std::string override") {
+    const string json = R"({"a":1})";
+    REQUIRE(renderer.renderToString("View", json) == R"(View:{"a":1})");
+    REQUIRE(renderer.renderToString("View", string_view(json)) ==
+            R"(View:{"a":1})");
+    REQUIRE(renderer.renderToString("View", "{}") == "View:{}");
+    REQUIRE(renderer.renderToString("View", Object{}) == "View");
+
+    StringStream stream;
+    Renderer &base = renderer;
+    base.render("View", "{}", stream);
+    base.render("View", string_view("[]"), stream);
+    REQUIRE(stream.str() == "View:{}View:[]");
+  }
+}
@@ -0,0 +1,147 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/exception.h>
+#include <complate/core/rendererpool.h>
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+#include "catch2/catch.hpp"
+#include "creatorspy.h"
+#include "nooprenderer.h"
+#include "noopstream.h"
+
+using namespace complate;
+using namespace std;
+using namespace std::chrono_literals;
+
+namespace {
+class SleepingRenderer : public NoopRenderer {
+public:
+  using NoopRenderer::render;
+
+  void render(const string &, const Object &, Stream &) override {
+    this_thread::sleep_for(50ms);
+  }
+};
+
+/** Blocks the renders until count of them are running at the same time */
+class MeetingRenderer : public NoopRenderer {
+public:
+  using NoopRenderer::render;
+
+  struct Latch {
+    mutex m_mutex;
+    condition_variable m_arrived;
+    int m_count;
+  };
+
+  explicit MeetingRenderer(Latch &latch) : m_latch(latch) {}
+
+  void render(const string &, const Object &, Stream &) override {
+    unique_lock<mutex> lock(m_latch.m_mutex);
+    if (--m_latch.m_count <= 0) {
+      m_latch.m_arrived.notify_all();
+    } else {
+      m_latch.m_arrived.wait(lock, [this] { return m_latch.m_count <= 0; });
+    }
+  }
+
+private:
+  Latch &m_latch;
+};
+}  // namespace
+
+TEST_CASE("RendererPool", "[core]") {
+  CreatorSpy creator([] { return make_unique<NoopRenderer>(); });
+  auto stream = NoopStream();
+  const Object parameters;
+
+  SECTION("create minSize renderers upon construction") {
+    RendererPool::Options options;
+    options.minSize = 2;
+    options.maxSize = 4;
+    RendererPool pool(creator, options);
+    REQUIRE(creator.callCount() == 2);
+    REQUIRE(pool.stats().size == 2);
+    REQUIRE(pool.stats().idle == 2);
+  }
+
+  SECTION("reuse an idle renderer") {
+    RendererPool pool(creator);
+    pool.render("View", parameters, stream);
+    pool.render("View", string("{}"), stream);
+    pool.renderToString("View", parameters);
+    REQUIRE(creator.callCount() == 1);
+    REQUIRE(pool.stats().busy == 0);
+  }
+
+  SECTION("never exceed maxSize") {
+    RendererPool::Options options;
+    options.minSize = 0;
+    options.maxSize = 2;
+    RendererPool pool(creator, options);
+    vector<thread> threads;
+    for (int i = 0; i < 8; ++i) {
+      threads.emplace_back([&] {
+        for (int j = 0; j < 10; ++j) {
+          pool.render("View", parameters, stream);
+        }
+      });
+    }
+    for (auto &t : threads) {
+      t.join();
+    }
+    REQUIRE(creator.callCount() <= 2);
+    REQUIRE(pool.stats().size <= 2);
+    REQUIRE(pool.stats().busy == 0);
+  }
+
+  SECTION("throws complate::Exception when waitTimeout exceeded") {
+    RendererPool::Options options;
+    options.maxSize = 1;
+    options.waitTimeout = 1ms;
+    RendererPool pool([] { return make_unique<SleepingRenderer>(); }, options);
+    thread blocker([&] { pool.render("View", parameters, stream); });
+    while (pool.stats().busy == 0) {
+      this_thread::yield();
+    }
+    REQUIRE_THROWS_AS(pool.render("View", parameters, stream),
+                      complate::Exception);
+    blocker.join();
+    REQUIRE(pool.stats().timeouts == 1);
+  }
+
+  SECTION("evict renderers idle longer than idleTimeout") {
+    RendererPool::Options options;
+    options.minSize = 1;
+    options.maxSize = 2;
+    options.idleTimeout = 1ms;
+    MeetingRenderer::Latch latch{{}, {}, 2};
+    RendererPool pool([&] { return make_unique<MeetingRenderer>(latch); },
+                      options);
+    thread other([&] { pool.render("View", parameters, stream); });
+    pool.render("View", parameters, stream);
+    other.join();
+    REQUIRE(pool.stats().size == 2);
+
+    this_thread::sleep_for(5ms);
+    pool.evictIdle();
+    REQUIRE(pool.stats().size == 1);
+    REQUIRE(pool.stats().evicted == 1);
+  }
+}
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/core/sharedvalue.h>
+#include <complate/core/value.h>
+
+#include "catch2/catch.hpp"
+
+using namespace complate;
+using namespace std;
+
+TEST_CASE("SharedValue", "[core]") {
+  const SharedValue shared(Object{{"name", "Klaus"}, {"tags", Array{1, 2}}});
+
+  SECTION("share the Value when copied") {
+    Value first = shared;
+    Value second = Object{{"nested", first}};
+    REQUIRE(shared.useCount() == 3);
+    REQUIRE(&first.exactly<SharedValue>().value() == &shared.value());
+  }
+
+  SECTION("be transparent for is, get and optional") {
+    Value value = shared;
+    REQUIRE(value.holds<SharedValue>());
+    REQUIRE_FALSE(value.holds<Object>());
+    REQUIRE(value.is<Object>());
+    REQUIRE(value.get<Object>().at("name") == "Klaus");
+    REQUIRE(Value(SharedValue(Value(23))).optional<int32_t>() == 23);
+    REQUIRE(Value(SharedValue(Value(shared))).is<Object>());
+    REQUIRE(Value(SharedValue(Value())).is<Undefined>());
+  }
+
+  SECTION("compare the referenced Value") {
+    REQUIRE(Value(shared) == Value(shared));
+    REQUIRE(Value(shared) ==
+            Value(Object{{"name", "Klaus"}, {"tags", Array{1, 2}}}));
+    REQUIRE(Value(shared) != Value(SharedValue(Value(Object{}))));
+  }
+
+  SECTION("copy on write") {
+    SharedValue copy = shared;
+    copy.mutate() = "changed";
+    REQUIRE(shared.value().is<Object>());
+    REQUIRE(copy.value() == "changed");
+
+    const Value *before = &copy.value();
+    copy.mutate() = "again";
+    REQUIRE(&copy.value() == before);
+  }
+}
@@ -16,16 +16,39 @@
 #if !defined(__MINGW32__) && !defined(__MINGW64__)
 #include <complate/core/threadlocalrenderer.h>
 
+#include <atomic>
+#include <future>
 #include <thread>
 
 #include "catch2/catch.hpp"
 #include "creatorspy.h"
 #include "nooprenderer.h"
+#include "noopstream.h"
 #include "stream.mock.h"
 
 using namespace complate;
 using namespace std;
 
+namespace {
+class NamedRenderer : public NoopRenderer {
+public:
+  using NoopRenderer::render;
+
+  explicit NamedRenderer(string name) : m_name(move(name)) {}
+  ~NamedRenderer() override { ++m_deleted; }
+
+  void render(const string &, const Object &, Stream &stream) override {
+    stream.write(m_name.data(), (int)m_name.size());
+  }
+
+  static atomic<int> m_deleted;
+
+private:
+  string m_name;
+};
+atomic<int> NamedRenderer::m_deleted = 0;
+}  // namespace
+
 TEST_CASE("ThreadLocalRenderer", "[core]") {
   CreatorSpy creator([] { return make_unique<NoopRenderer>(); });
   ThreadLocalRenderer renderer(creator);
@@ -96,6 +119,48 @@ TEST_CASE("ThreadLocalRenderer", "[core]") {
       REQUIRE(creator.callCount() == 2);
     }
   }
+
+  SECTION("keep the renderers of several instances apart") {
+    CreatorSpy otherCreator([] { return make_unique<NamedRenderer>("other"); });
+    ThreadLocalRenderer named(
+        [] { return make_unique<NamedRenderer>("named"); });
+    ThreadLocalRenderer other(otherCreator);
+    REQUIRE(named.renderToString("View", Object()) == "named");
+    REQUIRE(other.renderToString("View", Object()) == "other");
+    REQUIRE(named.renderToString("View", Object()) == "named");
+    REQUIRE(other.renderToString("View", Object()) == "other");
+    REQUIRE(otherCreator.callCount() == 1);
+  }
+
+  SECTION("delete the renderers of all threads on destruction") {
+    NamedRenderer::m_deleted = 0;
+    NoopStream noop;
+    auto instance = make_unique<ThreadLocalRenderer>(
+        [] { return make_unique<NamedRenderer>("named"); });
+    promise<void> rendered;
+    promise<void> destroyed;
+    thread t([&] {
+      instance->render("View", Object(), noop);
+      rendered.set_value();
+      destroyed.get_future().wait();
+    });
+    rendered.get_future().wait();
+    instance->render("View", Object(), noop);
+    instance.reset();
+    REQUIRE(NamedRenderer::m_deleted == 2);
+    destroyed.set_value();
+    t.join();
+    REQUIRE(NamedRenderer::m_deleted == 2);
+  }
+
+  SECTION("delete the renderer when its thread exits") {
+    NamedRenderer::m_deleted = 0;
+    NoopStream noop;
+    ThreadLocalRenderer named(
+        [] { return make_unique<NamedRenderer>("named"); });
+    thread([&] { named.render("View", Object(), noop); }).join();
+    REQUIRE(NamedRenderer::m_deleted == 1);
+  }
 }
 
 #endif // !defined(__MINGW32__) && !defined(__MINGW64__)
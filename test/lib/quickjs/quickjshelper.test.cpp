@@ -46,6 +46,35 @@ TEST_CASE("QuickJsHelper", "[quickjs]") {
     }
   }
 
+  SECTION("compile") {
+    SECTION("bytecode can be evaluated") {
+      const string bundle = Resources::read("views.js");
+      const vector<uint8_t> bytecode = QuickJsHelper::compile(context, bundle);
+      REQUIRE_FALSE(bytecode.empty());
+
+      JSContext *other = JS_NewContext(runtime);
+      QuickJsHelper::evaluate(other, bytecode);
+      JSValue render = QuickJsHelper::getFunction(other, "render");
+      REQUIRE(JS_IsFunction(other, render));
+      JS_FreeValue(other, render);
+      JS_FreeContext(other);
+    }
+
+    SECTION("throws complate::Exception when source is malformed") {
+      const string malformed = Resources::read("views.js.malformed");
+      REQUIRE_THROWS_AS(QuickJsHelper::compile(context, malformed),
+                        complate::Exception);
+      REQUIRE_THROWS_WITH(QuickJsHelper::compile(context, malformed),
+                          Contains("SyntaxError"));
+    }
+
+    SECTION("throws complate::Exception when bytecode is malformed") {
+      const vector<uint8_t> malformed = {0x01, 0x02, 0x03};
+      REQUIRE_THROWS_AS(QuickJsHelper::evaluate(context, malformed),
+                        complate::Exception);
+    }
+  }
+
   SECTION("getFunction") {
     SECTION("return the function") {
       QuickJsHelper::evaluate(context, "function foo() {};");
@@ -68,6 +68,53 @@ TEST_CASE("QuickJsMapper", "[quickjs]") {
     }
   }
 
+  SECTION("fromObjectLazy") {
+    const Object obj = {
+        {"name", "Klaus"},
+        {"address", Object{{"city", "Berlin"}}},
+        {"todos", Array{Object{{"title", "Eating"}}, "Sleeping"}}};
+    v = mapper.fromObjectLazy(obj);
+    JSValue global = JS_GetGlobalObject(context);
+    JS_SetPropertyStr(context, global, "p", JS_DupValue(context, v));
+    JS_FreeValue(context, global);
+    auto eval = [&](const string &code) {
+      JSValue rc =
+          JS_Eval(context, code.c_str(), code.size(), "<eval>", 0);
+      const char *str = JS_ToCString(context, rc);
+      string result = str;
+      JS_FreeCString(context, str);
+      JS_FreeValue(context, rc);
+      return result;
+    };
+
+    SECTION("convert fields on access") {
+      REQUIRE(eval("p.name") == "Klaus");
+      REQUIRE(eval("p.address.city") == "Berlin");
+      REQUIRE(eval("p.todos[0].title + p.todos[1]") == "EatingSleeping");
+      REQUIRE(eval("Array.isArray(p.todos)") == "true");
+      REQUIRE(eval("p.missing") == "undefined");
+    }
+
+    SECTION("keep converted fields") {
+      REQUIRE(eval("p.address === p.address") == "true");
+    }
+
+    SECTION("behave like an ordinary object") {
+      REQUIRE(eval("Object.keys(p).join()") == "address,name,todos");
+      REQUIRE(eval("'name' in p && p.hasOwnProperty('name')") == "true");
+      REQUIRE(eval("JSON.stringify(p.address)") == R"({"city":"Berlin"})");
+      REQUIRE(eval("p.name = 'Peter'; p.name") == "Peter");
+      REQUIRE(eval("delete p.name; 'name' in p") == "false");
+      REQUIRE(eval("Object.keys(p).join()") == "address,todos");
+    }
+
+    SECTION("appear empty after the render") {
+      rctx.proxyHolder().clear();
+      REQUIRE(eval("p.name") == "undefined");
+      REQUIRE(eval("Object.keys(p).length") == "0");
+    }
+  }
+
   SECTION("fromArray") {
     SECTION("convert nested objects") {
       const Array arr = {Object{{"name", "John"}}, Object{{"name", "Jane"}}};
@@ -181,6 +228,15 @@ TEST_CASE("QuickJsMapper", "[quickjs]") {
       REQUIRE(JS_IsFunction(context, method));
       JS_FreeValue(context, method);
     }
+
+    SECTION("convert SharedValue") {
+      const SharedValue shared(Object{{"a", 16}});
+      v = mapper.fromValue(shared);
+      REQUIRE(JS_IsObject(v));
+      JSValue a = JS_GetPropertyStr(context, v, "a");
+      REQUIRE(JS_IsNumber(a));
+      JS_FreeValue(context, a);
+    }
   }
 
   JS_FreeValue(context, v);
@@ -13,10 +13,13 @@
  *  See the License for the specific language governing permissions and
  *  limitations under the License.
  */
+#include "../../../lib/quickjs/quickjsproxydeleter.h"
 #include "../../../lib/quickjs/quickjsrenderercontext.h"
 
 #include <complate/core/prototypebuilder.h>
 
+#include <cstring>
+
 #include "catch2/catch.hpp"
 #include "quickjs.h"
 #include "testdata.h"
@@ -26,9 +29,62 @@ using namespace Catch::literals;
 using namespace complate;
 using namespace std;
 
+namespace {
+class Typed {
+public:
+  [[nodiscard]] int add(int value, bool twice) const {
+    return twice ? 2 * value : value;
+  }
+
+  [[nodiscard]] string_view name() const { return "typed"; }
+
+  [[nodiscard]] string greet(string_view greeting) const {
+    return string(greeting) + " typed";
+  }
+
+  void remove(int) { ++m_removes; }
+
+  [[nodiscard]] int removes() const { return m_removes; }
+
+private:
+  int m_removes = 0;
+};
+
+class Counted {
+public:
+  [[nodiscard]] int value() const { return ++m_calls * 10; }
+  void setValue(const Value &) {}
+
+  [[nodiscard]] int calls() const { return m_calls; }
+
+private:
+  mutable int m_calls = 0;
+};
+
+/** Frees the context after the QuickJsRendererContext using it */
+struct ContextGuard {
+  JSRuntime *m_runtime;
+  JSContext *m_context;
+  ~ContextGuard() {
+    JS_FreeContext(m_context);
+    JS_FreeRuntime(m_runtime);
+  }
+};
+
+string evaluate(JSContext *context, const char *script) {
+  JSValue r = JS_Eval(context, script, strlen(script), "<test>", 0);
+  const char *str = JS_ToCString(context, r);
+  string result = str;
+  JS_FreeCString(context, str);
+  JS_FreeValue(context, r);
+  return result;
+}
+}  // namespace
+
 TEST_CASE("QuickJsPrototypeRegistry", "[quickjs]") {
   JSRuntime *runtime = JS_NewRuntime();
   JSContext *context = JS_NewContext(runtime);
+  ContextGuard guard{runtime, context};
   QuickJsRendererContext rctx(context, Testdata::prototypes());
   auto &registry = rctx.prototypeRegistry();
   JSValue v;
@@ -144,7 +200,201 @@ TEST_CASE("QuickJsPrototypeRegistry", "[quickjs]") {
     REQUIRE(text == "foobar");
   }
 
+  SECTION("method receives its arguments") {
+    vector<Array> calls;
+    Prototype prototype("Recorder");
+    prototype.addMethod(Method("record", [&](void *, const Array &args) {
+      calls.push_back(args);
+      return Value((int32_t)args.size());
+    }));
+    registry.add(prototype);
+    string text = "foo";
+    v = registry.newInstanceOf(ProxyWeak("Recorder", &text));
+    JSValue global = JS_GetGlobalObject(context);
+    JS_SetPropertyStr(context, global, "recorder", JS_DupValue(context, v));
+    JS_FreeValue(context, global);
+
+    const char *script =
+        "[recorder.record(), recorder.record(1, 'a'),"
+        " recorder.record(1, 2, 3, 4, 5), recorder.record(true)].join()";
+    JSValue r = JS_Eval(context, script, strlen(script), "<test>", 0);
+    const char *result = JS_ToCString(context, r);
+    REQUIRE(string(result) == "0,2,5,1");
+    REQUIRE(calls.size() == 4);
+    REQUIRE(calls[1] == Array{1, "a"});
+    REQUIRE(calls[2] == Array{1, 2, 3, 4, 5});
+    REQUIRE(calls[3] == Array{true});
+
+    JS_FreeCString(context, result);
+    JS_FreeValue(context, r);
+  }
+
+  SECTION("nested method calls keep their arguments") {
+    Prototype prototype("Nested");
+    prototype.addMethod(Method("call", [&](void *, const Array &args) {
+      Value first = args.at(0);
+      if (args.size() > 1) {
+        const char *inner = "inner = nested.call('inner', 1, 2)";
+        JS_FreeValue(context, JS_Eval(context, inner, strlen(inner),
+                                      "<inner>", 0));
+      }
+      return Value(first.get<string>() + ":" + to_string(args.size()));
+    }));
+    registry.add(prototype);
+    string text = "foo";
+    v = registry.newInstanceOf(ProxyWeak("Nested", &text));
+    JSValue global = JS_GetGlobalObject(context);
+    JS_SetPropertyStr(context, global, "nested", JS_DupValue(context, v));
+    JS_FreeValue(context, global);
+
+    const char *script =
+        "var inner; var outer = nested.call('outer', true);"
+        "outer + ',' + inner";
+    JSValue r = JS_Eval(context, script, strlen(script), "<test>", 0);
+    const char *result = JS_ToCString(context, r);
+    REQUIRE(string(result) == "outer:2,inner:3");
+
+    JS_FreeCString(context, result);
+    JS_FreeValue(context, r);
+  }
+
+  SECTION("typed method and property convert without Value") {
+    registry.add(PrototypeBuilder<Typed>("Typed")
+                     .method("add", &Typed::add)
+                     .method("greet", &Typed::greet)
+                     .method("remove", &Typed::remove)
+                     .property("name", &Typed::name)
+                     .build());
+    Typed typed;
+    v = registry.newInstanceOf(ProxyWeak("Typed", &typed));
+    JSValue global = JS_GetGlobalObject(context);
+    JS_SetPropertyStr(context, global, "typed", JS_DupValue(context, v));
+    JS_FreeValue(context, global);
+
+    const char *script =
+        "var thrown = '';"
+        "try { typed.add({ valueOf() { throw 'x'; } }); }"
+        "catch (e) { thrown += e; }"
+        "try { typed.remove({ valueOf() { throw 'y'; } }); }"
+        "catch (e) { thrown += e; }"
+        "[typed.add(20, true), typed.add('3'), typed.name,"
+        " typed.greet('hi'), thrown].join()";
+    JSValue r = JS_Eval(context, script, strlen(script), "<test>", 0);
+    const char *result = JS_ToCString(context, r);
+    REQUIRE(string(result) == "40,3,typed,hi typed,xy");
+    REQUIRE(typed.removes() == 0);
+
+    JS_FreeCString(context, result);
+    JS_FreeValue(context, r);
+  }
+
+  SECTION("pure property is memoized while the deleter lives") {
+    registry.add(PrototypeBuilder<Counted>("Counted")
+                     .property("value", &Counted::value, &Counted::setValue)
+                     .property("impure", &Counted::value)
+                     .pure("value")
+                     .build());
+    Counted counted;
+    Counted other;
+    v = registry.newInstanceOf(ProxyWeak("Counted", &counted));
+    JSValue global = JS_GetGlobalObject(context);
+    JS_SetPropertyStr(context, global, "counted", JS_DupValue(context, v));
+    JS_SetPropertyStr(context, global, "other",
+                      registry.newInstanceOf(ProxyWeak("Counted", &other)));
+    JS_FreeValue(context, global);
+
+    REQUIRE(evaluate(context, "[counted.value, counted.value].join()") ==
+            "10,20");
+    {
+      QuickJsProxyDeleter deleter(rctx.proxyHolder(), registry);
+      REQUIRE(evaluate(context, "[counted.value, counted.value, other.value]"
+                                ".join()") == "30,30,10");
+      REQUIRE(counted.calls() == 3);
+      evaluate(context, "counted.value = 1");
+      REQUIRE(evaluate(context, "[counted.value, counted.value].join()") ==
+              "40,40");
+      REQUIRE(evaluate(context, "[counted.impure, counted.impure].join()") ==
+              "50,60");
+    }
+    REQUIRE(evaluate(context, "'' + counted.value") == "70");
+  }
+
+  SECTION("snapshot prototype maps to an object holding the values") {
+    registry.add(PrototypeBuilder<Counted>("Snapshot")
+                     .property("value", &Counted::value)
+                     .property("calls", &Counted::calls)
+                     .snapshot()
+                     .build());
+    registry.add(PrototypeBuilder<Counted>("SnapshotWithMethod")
+                     .property("value", &Counted::value)
+                     .method("calls", &Counted::calls)
+                     .snapshot()
+                     .build());
+    Counted counted;
+    Counted withMethod;
+    v = registry.newInstanceOf(ProxyWeak("Snapshot", &counted));
+    JSValue global = JS_GetGlobalObject(context);
+    JS_SetPropertyStr(context, global, "snapshot", JS_DupValue(context, v));
+    JS_SetPropertyStr(
+        context, global, "withMethod",
+        registry.newInstanceOf(ProxyWeak("SnapshotWithMethod", &withMethod)));
+    JS_FreeValue(context, global);
+    REQUIRE(counted.calls() == 1);
+
+    REQUIRE(evaluate(context, "[snapshot.value, snapshot.value, "
+                              "snapshot.calls].join()") == "10,10,1");
+    REQUIRE(evaluate(context, "Object.keys(snapshot).join()") ==
+            "value,calls");
+    REQUIRE(counted.calls() == 1);
+    REQUIRE(evaluate(context,
+                     "[withMethod.value, withMethod.calls()].join()") ==
+            "10,1");
+  }
+
+  SECTION("snapshot keeps its property names when JavaScript deletes them") {
+    registry.add(PrototypeBuilder<Counted>("Deletable")
+                     .property("remaining", &Counted::value)
+                     .method("calls", &Counted::calls)
+                     .snapshot()
+                     .build());
+    Counted first;
+    v = registry.newInstanceOf(ProxyWeak("Deletable", &first));
+    JSValue global = JS_GetGlobalObject(context);
+    JS_SetPropertyStr(context, global, "deletable", JS_DupValue(context, v));
+    JS_FreeValue(context, global);
+    REQUIRE(evaluate(context,
+                     "delete Object.getPrototypeOf(deletable).remaining;"
+                     "delete deletable.remaining;"
+                     "'' + deletable.remaining") == "undefined");
+    JS_RunGC(runtime);
+    /* would take the slot of a freed atom */
+    JSAtom unrelated = JS_NewAtom(context, "unrelated");
+
+    Counted second;
+    JSValue other = registry.newInstanceOf(ProxyWeak("Deletable", &second));
+    JSValue remaining = JS_GetPropertyStr(context, other, "remaining");
+    int32_t i = 0;
+    JS_ToInt32(context, &i, remaining);
+    REQUIRE(i == 10);
+
+    JS_FreeValue(context, remaining);
+    JS_FreeValue(context, other);
+    JS_FreeAtom(context, unrelated);
+  }
+
+  SECTION("method called on another object returns undefined") {
+    string text = "foo";
+    v = registry.newInstanceOf(ProxyWeak("std::string", &text));
+
+    JSValue mEmpty = JS_GetPropertyStr(context, v, "empty");
+    JSValue other = JS_NewObject(context);
+    JSValue rEmpty = JS_Call(context, mEmpty, other, 0, nullptr);
+    REQUIRE(JS_IsUndefined(rEmpty));
+
+    JS_FreeValue(context, rEmpty);
+    JS_FreeValue(context, other);
+    JS_FreeValue(context, mEmpty);
+  }
+
   JS_FreeValue(context, v);
-  JS_FreeContext(context);
-  JS_FreeRuntime(runtime);
 }
\ No newline at end of file
@@ -42,6 +42,32 @@ TEST_CASE("QuickJsRenderer", "[quickjs]") {
     }
   }
 
+  SECTION("constructor with bytecode") {
+    SECTION("generate expected output for TodoList") {
+      const auto bytecode =
+          QuickJsBytecode::compile(Resources::read("views.js"));
+      QuickJsRenderer renderer(bytecode, Testdata::prototypes(),
+                               Testdata::bindings());
+      renderer.render("TodoList", Testdata::forTodoList(), stream);
+      REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
+    }
+
+    SECTION("throws complate::Exception when source bundle is malformed") {
+      const string malformed = Resources::read("views.js.malformed");
+      REQUIRE_THROWS_AS(QuickJsBytecode::compile(malformed),
+                        complate::Exception);
+      REQUIRE_THROWS_WITH(QuickJsBytecode::compile(malformed),
+                          Contains("SyntaxError"));
+    }
+
+    SECTION("throws complate::Exception when render function is not defined") {
+      const auto bytecode = QuickJsBytecode::compile("");
+      REQUIRE_THROWS_AS(QuickJsRenderer(bytecode), complate::Exception);
+      REQUIRE_THROWS_WITH(QuickJsRenderer(bytecode),
+                          Contains("ReferenceError") && Contains("render"));
+    }
+  }
+
   SECTION("render map parameters") {
     SECTION("generate expected output for TodoList") {
       QuickJsRenderer renderer(Resources::read("views.js"),
@@ -50,6 +76,16 @@ TEST_CASE("QuickJsRenderer", "[quickjs]") {
       REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
     }
 
+    SECTION("generate expected output for TodoList with lazy mapping") {
+      QuickJsRenderer renderer(Resources::read("views.js"),
+                               Testdata::prototypes(), Testdata::bindings());
+      renderer.setLazyMapping(true);
+      renderer.render("TodoList", Testdata::forTodoList(), stream);
+      renderer.render("TodoList", Testdata::forTodoList(), stream);
+      REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html") +
+                                        Resources::read("todolist.html")));
+    }
+
     SECTION("throws complate::Exception when view is not defined") {
       QuickJsRenderer renderer(Resources::read("views.js"),
                                Testdata::prototypes(), Testdata::bindings());
@@ -110,4 +146,237 @@ TEST_CASE("QuickJsRenderer", "[quickjs]") {
       REQUIRE_THAT(html, Equals(Resources::read("todolist.html")));
     }
   }
+
+  SECTION("memo") {
+    const string source =
+        "var count = 0;"
+        "function render(view, params, stream) {"
+        "  var footer = memo('footer', function() {"
+        "    return function(s, options, callback) {"
+        "      count++;"
+        "      s.write('<p>' + params.text + '</p>');"
+        "      callback();"
+        "    };"
+        "  });"
+        "  var outer = memo('outer', function() {"
+        "    return function(s, options, callback) {"
+        "      s.write('[');"
+        "      footer(s, options, function() { s.write(']'); callback(); });"
+        "    };"
+        "  });"
+        "  var page = view === 'Outer' ? outer : footer;"
+        "  page(stream, {}, function() { stream.write(' ' + count); });"
+        "}";
+    auto cache = make_shared<MemoCache>();
+    QuickJsRenderer renderer(source);
+    renderer.setMemoCache(cache);
+
+    SECTION("replay the html of a key") {
+      REQUIRE(renderer.renderToString("View", Object{{"text", "a"}}) ==
+              "<p>a</p> 1");
+      REQUIRE(renderer.renderToString("View", Object{{"text", "b"}}) ==
+              "<p>a</p> 1");
+      REQUIRE(*cache->get("footer") == "<p>a</p>");
+    }
+
+    SECTION("render again when invalidated") {
+      renderer.renderToString("View", Object{{"text", "a"}});
+      cache->invalidate("footer");
+      REQUIRE(renderer.renderToString("View", Object{{"text", "b"}}) ==
+              "<p>b</p> 2");
+    }
+
+    SECTION("replay nested memos") {
+      renderer.renderToString("View", Object{{"text", "a"}});
+      REQUIRE(renderer.renderToString("Outer", Object{{"text", "b"}}) ==
+              "[<p>a</p>] 1");
+      REQUIRE(*cache->get("outer") == "[<p>a</p>]");
+    }
+
+    SECTION("share the cache between renderers") {
+      QuickJsRenderer other(source);
+      other.setMemoCache(cache);
+      renderer.renderToString("View", Object{{"text", "a"}});
+      REQUIRE(other.renderToString("View", Object{{"text", "b"}}) ==
+              "<p>a</p> 0");
+    }
+
+    SECTION("prefer a binding named memo") {
+      QuickJsRenderer bound("function render(view, params, stream) {"
+                  "  stream.write(memo());"
+                  "}",
+                  {}, Object{{"memo", Function([] { return "bound"; })}});
+      bound.setMemoCache(cache);
+      REQUIRE(bound.renderToString("View", Object{}) == "bound");
+    }
+  }
+
+  SECTION("htmlEncode") {
+    const string source =
+        "var text = 'plain text';"
+        "var html = { toString: function() { return '<b>'; } };"
+        "function render(view, params, stream) {"
+        "  stream.write([htmlEncode(params.text, params.attribute),"
+        "                htmlEncode(text) === text,"
+        "                htmlEncode(html), htmlEncode(42)].join());"
+        "}";
+    QuickJsRenderer renderer(source);
+    renderer.setHtmlEncode(true);
+
+    SECTION("escape strings and return them when there is nothing to escape") {
+      REQUIRE(renderer.renderToString(
+                  "View", Object{{"text", "'Tom' & Jerry"}}) ==
+              "'Tom' &amp; Jerry,true,&lt;b&gt;,42");
+      REQUIRE(renderer.renderToString(
+                  "View", Object{{"text", "'Tom'"}, {"attribute", true}}) ==
+              "&#x27;Tom&#x27;,true,&lt;b&gt;,42");
+    }
+
+    SECTION("escape non ascii strings") {
+      const Object parameters{{"text", "K\xc3\xa4se & \xe2\x82\xac"}};
+      REQUIRE(renderer.renderToString("View", parameters) ==
+              "K\xc3\xa4se &amp; \xe2\x82\xac,true,&lt;b&gt;,42");
+    }
+
+    SECTION("remove it again") {
+      renderer.setHtmlEncode(false);
+      REQUIRE_THROWS_AS(renderer.renderToString("View", Object{}),
+                        complate::Exception);
+    }
+
+    SECTION("prefer a binding named htmlEncode") {
+      QuickJsRenderer bound("function render(view, params, stream) {"
+                  "  stream.write(htmlEncode('<'));"
+                  "}",
+                  {}, Object{{"htmlEncode", Function([] { return "bound"; })}});
+      bound.setHtmlEncode(true);
+      REQUIRE(bound.renderToString("View", Object{}) == "bound");
+    }
+
+    SECTION("serve a bundle delegating complate-stream's htmlEncode to it") {
+      /* complate-stream's htmlEncode is scoped to the bundle, see the
+       * USER_GUIDE how to let it call the global one */
+      string bundle = Resources::read("views.js");
+      const string declaration = "function htmlEncode(str, attribute) {";
+      bundle.insert(bundle.find(declaration) + declaration.size(),
+                    "\n\treturn globalThis.htmlEncode(str, attribute);");
+      QuickJsRenderer delegating(bundle, Testdata::prototypes(),
+                                 Testdata::bindings());
+      delegating.setHtmlEncode(true);
+
+      const Object person{{"person", Object{{"name", "Tom & <Jerry>"}}}};
+      REQUIRE_THAT(delegating.renderToString("Greeting", person),
+                   Contains("<h1>Hello Tom &amp; &lt;Jerry&gt;</h1>"));
+      REQUIRE_THAT(
+          delegating.renderToString("TodoList", Testdata::forTodoList()),
+          Equals(Resources::read("todolist.html")));
+
+      delegating.setHtmlEncode(false);
+      REQUIRE_THROWS_AS(delegating.renderToString("Greeting", person),
+                        complate::Exception);
+    }
+  }
+
+  SECTION("render parsed parameters") {
+    QuickJsRenderer counter(
+        "var count = 0;"
+        "function render(view, params, stream) {"
+        "  stream.write(view + ':' + params.title + ':' + (++count) + ' ');"
+        "}");
+
+    SECTION("render them with several views") {
+      const ParsedParameters parameters = counter.parse(R"({"title": "T"})");
+      counter.render("Page", parameters, stream);
+      counter.render("Teaser", parameters, stream);
+      REQUIRE(counter.renderToString("Card", parameters) == "Card:T:3 ");
+      REQUIRE_THAT(stream.str(), Equals("Page:T:1 Teaser:T:2 "));
+    }
+
+    SECTION("generate expected output for TodoList") {
+      QuickJsRenderer renderer(Resources::read("views.js"),
+                               Testdata::prototypes(), Testdata::bindings());
+      const ParsedParameters parameters =
+          renderer.parse(Testdata::forTodoListViewAsJson());
+      renderer.render("TodoList", parameters, stream);
+      REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
+      REQUIRE_THAT(renderer.renderToString("TodoList", parameters),
+                   Equals(Resources::read("todolist.html")));
+    }
+
+    SECTION("keep changes of a view out of the following renders") {
+      QuickJsRenderer changing(
+          "function render(view, params, stream) {"
+          "  stream.write(params.title + ' ');"
+          "  params.title = view;"
+          "}");
+      const ParsedParameters parameters = changing.parse(R"({"title": "T"})");
+      changing.render("Page", parameters, stream);
+      changing.render("Teaser", parameters, stream);
+      REQUIRE_THAT(stream.str(), Equals("T T "));
+    }
+
+    SECTION("release expired parameters") {
+      for (int i = 0; i < 100; ++i) {
+        const ParsedParameters parameters = counter.parse(R"({"title": 1})");
+        counter.render("View", parameters, stream);
+      }
+      REQUIRE_THAT(stream.str(), Contains("View:1:100 "));
+    }
+
+    SECTION("throws complate::Exception if parameters is not an json object") {
+      REQUIRE_THROWS_WITH(counter.parse("[1"),
+                          Contains("SyntaxError") && Contains("parameters"));
+    }
+
+    SECTION("throws complate::Exception if parsed by another renderer") {
+      QuickJsRenderer other("function render() {}");
+      const ParsedParameters parameters = other.parse("{}");
+      REQUIRE_THROWS_AS(counter.render("View", parameters, stream),
+                        complate::Exception);
+      REQUIRE_THROWS_AS(counter.render("View", ParsedParameters(), stream),
+                        complate::Exception);
+    }
+  }
+
+  SECTION("shared parameters") {
+    QuickJsRenderer renderer(
+        "function render(view, params, stream) {"
+        "  stream.write(params.nav.items.join() + ' ' + params.title);"
+        "  stream.write(' ' + Object.isFrozen(params.nav.items));"
+        "}");
+    renderer.setSharedParameter("nav", Object{{"items", Array{"a", "b"}}});
+    renderer.setSharedParameter("title", "Shared");
+
+    SECTION("pass them with every render") {
+      renderer.render("View", Object{}, stream);
+      renderer.render("View", R"({})", stream);
+      REQUIRE_THAT(stream.str(), Equals("a,b Shared truea,b Shared true"));
+    }
+
+    SECTION("prefer fields of the parameters") {
+      renderer.render("View", Object{{"title", "Own"}}, stream);
+      REQUIRE_THAT(stream.str(), Equals("a,b Own true"));
+    }
+
+    SECTION("pass them with lazy mapping") {
+      renderer.setLazyMapping(true);
+      renderer.render("View", Object{}, stream);
+      REQUIRE_THAT(stream.str(), Equals("a,b Shared true"));
+    }
+
+    SECTION("pass the current ones with parsed parameters") {
+      const ParsedParameters parameters = renderer.parse("{}");
+      renderer.render("View", parameters, stream);
+      renderer.setSharedParameter("title", "Changed");
+      renderer.render("View", parameters, stream);
+      REQUIRE_THAT(stream.str(), Equals("a,b Shared truea,b Changed true"));
+    }
+
+    SECTION("replace and remove them") {
+      renderer.setSharedParameter("nav", Object{{"items", Array{"c"}}});
+      renderer.removeSharedParameter("title");
+      renderer.render("View", Object{}, stream);
+      REQUIRE_THAT(stream.str(), Equals("c undefined true"));
+    }
+  }
 }
@@ -51,6 +51,87 @@ TEST_CASE("QuickJsRendererBuilder", "[quickjs]") {
     REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
   }
 
+  SECTION("build with bytecode") {
+    auto renderer = QuickJsRendererBuilder()
+        .bytecode(QuickJsBytecode::compile(Resources::read("views.js")))
+        .prototypes(Testdata::prototypes())
+        .bindings(Testdata::bindings())
+        .build();
+
+    renderer.render("TodoList", Testdata::forTodoList(), stream);
+    REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
+  }
+
+  SECTION("build a creator with precompiled source") {
+    int sourceCalls = 0;
+    auto creator = QuickJsRendererBuilder()
+        .source([&sourceCalls]() {
+          ++sourceCalls;
+          return Resources::read("views.js");
+        })
+        .precompile()
+        .prototypes(Testdata::prototypes)
+        .bindings(Testdata::bindings)
+        .creator();
+
+    creator()->render("TodoList", Testdata::forTodoList(), stream);
+    creator()->render("TodoList", Testdata::forTodoList(), stream);
+    REQUIRE(sourceCalls == 1);
+    REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html") +
+                                      Resources::read("todolist.html")));
+  }
+
+  SECTION("build with native htmlEncode") {
+    auto renderer = QuickJsRendererBuilder()
+        .source("function render(view, params, stream) {"
+                "  stream.write(htmlEncode(params.text, true));"
+                "}")
+        .htmlEncode()
+        .build();
+
+    renderer.render("View", Object{{"text", "<'Tom' & \"Jerry\">"}}, stream);
+    REQUIRE_THAT(stream.str(),
+                 Equals("&lt;&#x27;Tom&#x27; &amp; &quot;Jerry&quot;&gt;"));
+  }
+
+  SECTION("build with lazy mapping") {
+    auto renderer = QuickJsRendererBuilder()
+        .source(Resources::read("views.js"))
+        .prototypes(Testdata::prototypes())
+        .bindings(Testdata::bindings())
+        .lazyMapping()
+        .build();
+
+    renderer.render("TodoList", Testdata::forTodoList(), stream);
+    REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
+  }
+
+  SECTION("build with shared parameters") {
+    auto renderer = QuickJsRendererBuilder()
+        .source("function render(view, params, stream) {"
+                "  stream.write(params.site.name);"
+                "}")
+        .sharedParameters(Object{{"site", Object{{"name", "complate"}}}})
+        .build();
+
+    renderer.render("View", Object{}, stream);
+    REQUIRE_THAT(stream.str(), Equals("complate"));
+  }
+
+  SECTION("build with memo cache") {
+    auto cache = make_shared<MemoCache>();
+    cache->put("footer", "<footer></footer>");
+    auto renderer = QuickJsRendererBuilder()
+        .source("function render(view, params, stream) {"
+                "  memo('footer', null)(stream, {}, function() {});"
+                "}")
+        .memoCache(cache)
+        .build();
+
+    renderer.render("View", Object{}, stream);
+    REQUIRE_THAT(stream.str(), Equals("<footer></footer>"));
+  }
+
   SECTION("build a unique_ptr") {
     unique_ptr<QuickJsRenderer> unique = QuickJsRendererBuilder()
         .source(Resources::read("views.js"))
@@ -24,6 +24,21 @@ using namespace trompeloeil;
 using namespace complate;
 using namespace std;
 
+namespace {
+class RecordingStream : public Stream {
+public:
+  void write(const char *str, int len) override {
+    m_pointers.push_back(str);
+    m_strings.emplace_back(str, len);
+  }
+  void writeln(const char *str, int len) override { write(str, len); }
+  void flush() override {}
+
+  vector<const char *> m_pointers;
+  vector<string> m_strings;
+};
+}  // namespace
+
 TEST_CASE("QuickJsStreamAdapter", "[quickjs]") {
   JSRuntime *runtime = JS_NewRuntime();
   JSContext *context = JS_NewContext(runtime);
@@ -41,6 +56,10 @@ TEST_CASE("QuickJsStreamAdapter", "[quickjs]") {
       var testFlush = function(stream) {
         stream.flush();
       }
+      var testWriteTwice = function(stream, str) {
+        stream.write(str);
+        stream.write(str);
+      }
   )");
 
   SECTION("forward write to stream") {
@@ -77,6 +96,54 @@ TEST_CASE("QuickJsStreamAdapter", "[quickjs]") {
     JS_FreeValue(context, testFlush);
   }
 
+  SECTION("zero-copy write of ASCII strings") {
+    RecordingStream recording;
+    JSValue args[2] = {streamAdapter.adapterFor(recording),
+                       JS_NewString(context, "<li>ASCII only</li>")};
+    JSValue fn = QuickJsHelper::getFunction(context, "testWriteTwice");
+    JSValue rc = JS_Call(context, fn, JS_UNDEFINED, 2, args);
+    CHECK(JS_IsException(rc) == 0);
+    REQUIRE(recording.m_strings[0] == "<li>ASCII only</li>");
+    REQUIRE(recording.m_pointers[0] == recording.m_pointers[1]);
+    JS_FreeValue(context, args[1]);
+    JS_FreeValue(context, fn);
+    argv[0] = args[0];
+  }
+
+  SECTION("convert non ASCII strings to UTF-8") {
+    const string latin1 = u8"Grüße";
+    const string wide = u8"5 €";
+    RecordingStream recording;
+    JSValue args[2] = {streamAdapter.adapterFor(recording),
+                       JS_NewString(context, (latin1 + wide).c_str())};
+    JSValue fn = QuickJsHelper::getFunction(context, "testWriteTwice");
+    JSValue rc = JS_Call(context, fn, JS_UNDEFINED, 2, args);
+    CHECK(JS_IsException(rc) == 0);
+    REQUIRE(recording.m_strings[1] == latin1 + wide);
+    JS_FreeValue(context, args[1]);
+    args[1] = JS_NewString(context, latin1.c_str());
+    rc = JS_Call(context, fn, JS_UNDEFINED, 2, args);
+    CHECK(JS_IsException(rc) == 0);
+    REQUIRE(recording.m_strings[3] == latin1);
+    JS_FreeValue(context, args[1]);
+    JS_FreeValue(context, fn);
+    argv[0] = args[0];
+  }
+
+  SECTION("throw when the argument is not convertible to a string") {
+    RecordingStream recording;
+    JSValue args[2] = {streamAdapter.adapterFor(recording),
+                       JS_Eval(context, "Symbol()", 8, "<eval>", 0)};
+    JSValue fn = QuickJsHelper::getFunction(context, "testWriteTwice");
+    JSValue rc = JS_Call(context, fn, JS_UNDEFINED, 2, args);
+    REQUIRE(JS_IsException(rc) == 1);
+    REQUIRE(recording.m_strings.empty());
+    JS_FreeValue(context, JS_GetException(context));
+    JS_FreeValue(context, args[1]);
+    JS_FreeValue(context, fn);
+    argv[0] = args[0];
+  }
+
   JS_FreeValue(context, argv[0]);
   JS_FreeContext(context);
   JS_FreeRuntime(runtime);
@@ -0,0 +1,62 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#include <complate/v8/v8codecache.h>
+
+#include "catch2/catch.hpp"
+
+using namespace complate;
+using namespace std;
+
+TEST_CASE("V8CodeCache", "[v8]") {
+  V8CodeCache cache;
+  const uint64_t key = V8CodeCache::keyFor("var render = function() {};");
+
+  SECTION("keyFor") {
+    SECTION("is equal for equal sources") {
+      REQUIRE(key == V8CodeCache::keyFor("var render = function() {};"));
+    }
+
+    SECTION("differs for different sources") {
+      REQUIRE(key != V8CodeCache::keyFor("var render = function() {} ;"));
+      REQUIRE(V8CodeCache::keyFor("") != V8CodeCache::keyFor(" "));
+    }
+  }
+
+  SECTION("get and put") {
+    REQUIRE(cache.get(key) == nullptr);
+    cache.put(key, {1, 2, 3});
+    REQUIRE(*cache.get(key) == V8CodeCache::Data{1, 2, 3});
+    cache.put(key, {4});
+    REQUIRE(*cache.get(key) == V8CodeCache::Data{4});
+    REQUIRE(cache.stats().hits == 0);
+    REQUIRE(cache.stats().misses == 0);
+  }
+
+  SECTION("consume counts hits and misses") {
+    REQUIRE(cache.consume(key) == nullptr);
+    cache.put(key, {1, 2, 3});
+    REQUIRE(*cache.consume(key) == V8CodeCache::Data{1, 2, 3});
+    REQUIRE(cache.stats().hits == 1);
+    REQUIRE(cache.stats().misses == 1);
+  }
+
+  SECTION("reject removes the data and counts the rejection") {
+    cache.put(key, {1, 2, 3});
+    cache.reject(key);
+    REQUIRE(cache.get(key) == nullptr);
+    REQUIRE(cache.stats().rejections == 1);
+  }
+}
@@ -0,0 +1,65 @@
+/**
+ * Copyright 2021 Torsten Mehnert
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *      http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <complate/v8/v8renderer.h>
+
+#include "catch2/catch.hpp"
+#include "noopstream.h"
+
+using namespace complate;
+using namespace std;
+
+TEST_CASE("V8HtmlEncodeBenchmark", "[v8][.benchmark]") {
+  /* htmlEncode of complate-stream compared with the native one */
+  V8Renderer renderer(
+      "function jsEncode(str, attribute) {"
+      "  var res = str.replace(/&/g, '&amp;')"
+      "    .replace(/</g, '&lt;').replace(/>/g, '&gt;');"
+      "  if (attribute) {"
+      "    res = res.replace(/\"/g, '&quot;').replace(/'/g, '&#x27;');"
+      "  }"
+      "  return res;"
+      "}"
+      "function render(view, params, stream) {"
+      "  var encode = view === 'Native' ? htmlEncode : jsEncode;"
+      "  for (var i = 0; i < 100; i++) {"
+      "    stream.write(encode(params.text, params.attribute));"
+      "  }"
+      "}");
+  renderer.setHtmlEncode(true);
+  auto stream = NoopStream();
+
+  SECTION("encoding text of 100 nodes") {
+    const auto plain = Object{
+        {"text", "Lorem ipsum dolor sit amet, consetetur sadipscing elitr"}};
+    BENCHMARK("complate-stream without specials") {
+      renderer.render("Js", plain, stream);
+    };
+    BENCHMARK("native without specials") {
+      renderer.render("Native", plain, stream);
+    };
+
+    const auto special = Object{
+        {"text", "Lorem <ipsum> dolor & sit amet, 'consetetur' sadipscing"},
+        {"attribute", true}};
+    BENCHMARK("complate-stream with specials") {
+      renderer.render("Js", special, stream);
+    };
+    BENCHMARK("native with specials") {
+      renderer.render("Native", special, stream);
+    };
+  }
+}
@@ -82,6 +82,50 @@ TEST_CASE("V8Mapper", "[v8]") {
     }
   }
 
+  SECTION("fromObjectLazy") {
+    const Object obj = {
+        {"name", "Klaus"},
+        {"address", Object{{"city", "Berlin"}}},
+        {"todos", Array{Object{{"title", "Eating"}}, "Sleeping"}}};
+    context->Global()
+        ->Set(context, v8String("p"), mapper.fromObjectLazy(obj))
+        .ToChecked();
+    auto eval = [&](const string &code) {
+      auto script =
+          v8::Script::Compile(context, v8String(code)).ToLocalChecked();
+      v8::String::Utf8Value result(isolate,
+                                   script->Run(context).ToLocalChecked());
+      return string(*result);
+    };
+
+    SECTION("convert fields on access") {
+      REQUIRE(eval("p.name") == "Klaus");
+      REQUIRE(eval("p.address.city") == "Berlin");
+      REQUIRE(eval("p.todos[0].title + p.todos[1]") == "EatingSleeping");
+      REQUIRE(eval("Array.isArray(p.todos)") == "true");
+      REQUIRE(eval("p.missing") == "undefined");
+    }
+
+    SECTION("keep converted fields") {
+      REQUIRE(eval("p.address === p.address") == "true");
+    }
+
+    SECTION("behave like an ordinary object") {
+      REQUIRE(eval("Object.keys(p).join()") == "address,name,todos");
+      REQUIRE(eval("'name' in p && p.hasOwnProperty('name')") == "true");
+      REQUIRE(eval("JSON.stringify(p.address)") == R"({"city":"Berlin"})");
+      REQUIRE(eval("p.name = 'Peter'; p.name") == "Peter");
+      REQUIRE(eval("delete p.name; 'name' in p") == "false");
+      REQUIRE(eval("Object.keys(p).join()") == "address,todos");
+    }
+
+    SECTION("appear empty after the render") {
+      rctx.proxyHolder().clear();
+      REQUIRE(eval("p.name") == "undefined");
+      REQUIRE(eval("Object.keys(p).length") == "0");
+    }
+  }
+
   SECTION("fromArray") {
     SECTION("convert nested objects") {
       const Array arr = {Object{{"name", "John"}}, Object{{"name", "Jane"}}};
@@ -223,6 +267,14 @@ TEST_CASE("V8Mapper", "[v8]") {
       REQUIRE(method.ToLocalChecked()->IsFunction());
     }
 
+    SECTION("convert SharedValue") {
+      const SharedValue shared(Object{{"a", 16}});
+      v8::Local<v8::Value> value = mapper.fromValue(shared);
+      REQUIRE(value->IsObject());
+      auto obj = v8::Object::Cast(*value);
+      REQUIRE(obj->Get(context, v8String("a")).ToLocalChecked()->IsInt32());
+    }
+
     SECTION("convert ProxyWeak") {
       string foo = "foo";
       v8::Local<v8::Value> value =
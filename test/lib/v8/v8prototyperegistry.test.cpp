@@ -13,16 +13,56 @@
  *  See the License for the specific language governing permissions and
  *  limitations under the License.
  */
+#include "../../lib/v8/v8proxydeleter.h"
 #include "../../lib/v8/v8renderercontext.h"
+#include "../../lib/v8/v8streamadapter.h"
+
+#include <complate/core/prototypebuilder.h>
+#include <complate/core/stringstream.h>
 
 #include "catch2/catch.hpp"
 #include "testdata.h"
+#include "timespandto.h"
 
 using namespace Catch::Matchers;
 using namespace Catch::literals;
 using namespace complate;
 using namespace std;
 
+namespace {
+class Typed {
+public:
+  [[nodiscard]] int add(int value, bool twice) const {
+    return twice ? 2 * value : value;
+  }
+
+  [[nodiscard]] string_view name() const { return "typed"; }
+
+  [[nodiscard]] string greet(string_view greeting) const {
+    return string(greeting) + " typed";
+  }
+
+  [[nodiscard]] int64_t size() const { return 5; }
+
+  void remove(int) { ++m_removes; }
+
+  [[nodiscard]] int removes() const { return m_removes; }
+
+private:
+  int m_removes = 0;
+};
+
+class Counted {
+public:
+  [[nodiscard]] int value() const { return ++m_calls * 10; }
+
+  [[nodiscard]] int calls() const { return m_calls; }
+
+private:
+  mutable int m_calls = 0;
+};
+}  // namespace
+
 TEST_CASE("V8PrototypeRegistry", "[v8]") {
   v8::Isolate::CreateParams params;
   params.array_buffer_allocator =
@@ -165,4 +205,192 @@ TEST_CASE("V8PrototypeRegistry", "[v8]") {
 
     REQUIRE(text == "foobar");
   }
+
+  SECTION("typed method and property convert without Value") {
+    registry.add(PrototypeBuilder<Typed>("Typed")
+                     .method("add", &Typed::add)
+                     .method("greet", &Typed::greet)
+                     .method("remove", &Typed::remove)
+                     .property("name", &Typed::name)
+                     .property("size", &Typed::size)
+                     .build());
+    Typed typed;
+    auto object = registry.newInstanceOf(ProxyWeak("Typed", &typed));
+    context->Global()
+        ->Set(context,
+              v8::String::NewFromUtf8(isolate, "typed",
+                                      v8::NewStringType::kNormal)
+                  .ToLocalChecked(),
+              object)
+        .ToChecked();
+
+    auto source =
+        v8::String::NewFromUtf8(
+            isolate,
+            "var thrown = '';"
+            "try { typed.add({ valueOf() { throw 'x'; } }); }"
+            "catch (e) { thrown += e; }"
+            "try { typed.remove({ valueOf() { throw 'y'; } }); }"
+            "catch (e) { thrown += e; }"
+            "[typed.add(20, true), typed.add('3'), typed.name,"
+            " typed.greet('hi'), typeof typed.size, thrown].join()",
+            v8::NewStringType::kNormal)
+            .ToLocalChecked();
+    auto result = v8::Script::Compile(context, source)
+                      .ToLocalChecked()
+                      ->Run(context)
+                      .ToLocalChecked();
+    v8::String::Utf8Value text(isolate, result);
+    REQUIRE(string(*text) == "40,3,typed,hi typed,bigint,xy");
+    REQUIRE(typed.removes() == 0);
+  }
+
+  SECTION("method or property used on another object throws") {
+    string text = "foo";
+    auto object = registry.newInstanceOf(ProxyWeak("std::string", &text));
+    auto pObject = object->ToObject(context).ToLocalChecked();
+    auto empty =
+        pObject
+            ->Get(context, v8::String::NewFromUtf8(isolate, "empty",
+                                                   v8::NewStringType::kNormal)
+                               .ToLocalChecked())
+            .ToLocalChecked()
+            .As<v8::Function>();
+    auto illegal = [&](v8::Local<v8::Value> receiver) {
+      v8::TryCatch tryCatch(isolate);
+      auto result = empty->Call(context, receiver, 0, nullptr);
+      return result.IsEmpty() && tryCatch.HasCaught() &&
+             tryCatch.Exception()->IsNativeError();
+    };
+
+    TimespanDto timespan(1, "day", false);
+    REQUIRE(illegal(
+        registry.newInstanceOf(ProxyWeak("TimespanDto", &timespan))));
+    REQUIRE(illegal(v8::Object::New(isolate)));
+
+    StringStream stream;
+    V8StreamAdapter streamAdapter(isolate);
+    REQUIRE(illegal(streamAdapter.adapterFor(stream)));
+
+    context->Global()
+        ->Set(context,
+              v8::String::NewFromUtf8(isolate, "text",
+                                      v8::NewStringType::kNormal)
+                  .ToLocalChecked(),
+              object)
+        .ToChecked();
+    auto source = v8::String::NewFromUtf8(
+                      isolate,
+                      "try { Object.create(text).length; }"
+                      "catch (e) { e instanceof TypeError; }",
+                      v8::NewStringType::kNormal)
+                      .ToLocalChecked();
+    auto result = v8::Script::Compile(context, source)
+                      .ToLocalChecked()
+                      ->Run(context)
+                      .ToLocalChecked();
+    REQUIRE(result->IsTrue());
+  }
+
+  SECTION("pure property is memoized while the deleter lives") {
+    registry.add(PrototypeBuilder<Counted>("Counted")
+                     .property("value", &Counted::value)
+                     .pure("value")
+                     .build());
+    Counted counted;
+    context->Global()
+        ->Set(context,
+              v8::String::NewFromUtf8(isolate, "counted",
+                                      v8::NewStringType::kNormal)
+                  .ToLocalChecked(),
+              registry.newInstanceOf(ProxyWeak("Counted", &counted)))
+        .ToChecked();
+    auto evaluate = [&]() {
+      auto source = v8::String::NewFromUtf8(
+                        isolate, "[counted.value, counted.value].join()",
+                        v8::NewStringType::kNormal)
+                        .ToLocalChecked();
+      auto result = v8::Script::Compile(context, source)
+                        .ToLocalChecked()
+                        ->Run(context)
+                        .ToLocalChecked();
+      return string(*v8::String::Utf8Value(isolate, result));
+    };
+
+    REQUIRE(evaluate() == "10,20");
+    {
+      V8ProxyDeleter deleter(rctx.proxyHolder(), registry);
+      REQUIRE(evaluate() == "30,30");
+    }
+    REQUIRE(evaluate() == "40,50");
+  }
+
+  SECTION("pure property isn't memoized when it throws") {
+    int calls = 0;
+    registry.add(
+        PrototypeBuilder<Counted>("Throwing")
+            .property("value", function<int(Counted &)>([&](Counted &) {
+                        if (++calls == 1) {
+                          isolate->ThrowException(
+                              v8::String::NewFromUtf8(
+                                  isolate, "x", v8::NewStringType::kNormal)
+                                  .ToLocalChecked());
+                        }
+                        return calls * 10;
+                      }))
+            .pure("value")
+            .build());
+    Counted counted;
+    context->Global()
+        ->Set(context,
+              v8::String::NewFromUtf8(isolate, "throwing",
+                                      v8::NewStringType::kNormal)
+                  .ToLocalChecked(),
+              registry.newInstanceOf(ProxyWeak("Throwing", &counted)))
+        .ToChecked();
+
+    V8ProxyDeleter deleter(rctx.proxyHolder(), registry);
+    auto source = v8::String::NewFromUtf8(
+                      isolate,
+                      "var thrown;"
+                      "try { throwing.value; } catch (e) { thrown = e; }"
+                      "[thrown, throwing.value, throwing.value].join()",
+                      v8::NewStringType::kNormal)
+                      .ToLocalChecked();
+    auto result = v8::Script::Compile(context, source)
+                      .ToLocalChecked()
+                      ->Run(context)
+                      .ToLocalChecked();
+    REQUIRE(string(*v8::String::Utf8Value(isolate, result)) == "x,20,20");
+  }
+
+  SECTION("snapshot prototype maps to an object holding the values") {
+    registry.add(PrototypeBuilder<Counted>("Snapshot")
+                     .property("value", &Counted::value)
+                     .method("calls", &Counted::calls)
+                     .snapshot()
+                     .build());
+    Counted counted;
+    context->Global()
+        ->Set(context,
+              v8::String::NewFromUtf8(isolate, "snapshot",
+                                      v8::NewStringType::kNormal)
+                  .ToLocalChecked(),
+              registry.newInstanceOf(ProxyWeak("Snapshot", &counted)))
+        .ToChecked();
+    REQUIRE(counted.calls() == 1);
+
+    auto source = v8::String::NewFromUtf8(
+                      isolate,
+                      "[snapshot.value, snapshot.value, snapshot.calls(),"
+                      " snapshot.hasOwnProperty('value')].join()",
+                      v8::NewStringType::kNormal)
+                      .ToLocalChecked();
+    auto result = v8::Script::Compile(context, source)
+                      .ToLocalChecked()
+                      ->Run(context)
+                      .ToLocalChecked();
+    v8::String::Utf8Value text(isolate, result);
+    REQUIRE(string(*text) == "10,10,1,true");
+  }
 }
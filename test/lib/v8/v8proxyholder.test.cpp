@@ -37,4 +37,11 @@ TEST_CASE("V8ProxyHolder", "[v8]") {
     holder.clear();
     REQUIRE(proxy.ptr().use_count() == 1);
   }
-}
\ No newline at end of file
+
+  SECTION("clear change scope") {
+    V8ProxyHolder holder;
+    const uint32_t scope = holder.scope();
+    holder.clear();
+    REQUIRE(holder.scope() != scope);
+  }
+}
@@ -42,6 +42,66 @@ TEST_CASE("V8Renderer", "[v8]") {
     }
   }
 
+  SECTION("constructor with code cache") {
+    const string source = Resources::read("views.js");
+    auto codeCache = make_shared<V8CodeCache>();
+
+    SECTION("store code cache data and consume it afterwards") {
+      V8Renderer first(source, Testdata::prototypes(), Testdata::bindings(),
+                       codeCache);
+      REQUIRE(codeCache->get(V8CodeCache::keyFor(source)) != nullptr);
+      V8Renderer second(source, Testdata::prototypes(), Testdata::bindings(),
+                        codeCache);
+      second.render("TodoList", Testdata::forTodoList(), stream);
+      REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
+      REQUIRE(codeCache->stats().misses == 1);
+      REQUIRE(codeCache->stats().hits == 1);
+      REQUIRE(codeCache->stats().rejections == 0);
+    }
+
+    SECTION("replace code cache data rejected by V8") {
+      codeCache->put(V8CodeCache::keyFor(source), {0, 8, 15});
+      V8Renderer renderer(source, Testdata::prototypes(), Testdata::bindings(),
+                          codeCache);
+      renderer.render("TodoList", Testdata::forTodoList(), stream);
+      REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
+      REQUIRE(codeCache->stats().rejections == 1);
+      REQUIRE(codeCache->get(V8CodeCache::keyFor(source))->size() > 3);
+    }
+  }
+
+  SECTION("constructor with snapshot") {
+    SECTION("generate expected output for TodoList") {
+      const auto snapshot = V8Snapshot::create(Resources::read("views.js"));
+      V8Renderer renderer(snapshot, Testdata::prototypes(),
+                          Testdata::bindings());
+      renderer.render("TodoList", Testdata::forTodoList(), stream);
+      REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
+    }
+
+    SECTION("boot from a blob read from disk") {
+      const auto created = V8Snapshot::create(Resources::read("views.js"));
+      V8Renderer renderer(V8Snapshot(created.data()), Testdata::prototypes(),
+                          Testdata::bindings());
+      renderer.render("TodoList", Testdata::forTodoList(), stream);
+      REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
+    }
+
+    SECTION("throws complate::Exception when source bundle is malformed") {
+      const string malformed = Resources::read("views.js.malformed");
+      REQUIRE_THROWS_AS(V8Snapshot::create(malformed), complate::Exception);
+      REQUIRE_THROWS_WITH(V8Snapshot::create(malformed),
+                          Contains("SyntaxError"));
+    }
+
+    SECTION("throws complate::Exception when render function is not defined") {
+      const auto snapshot = V8Snapshot::create("");
+      REQUIRE_THROWS_AS(V8Renderer(snapshot), complate::Exception);
+      REQUIRE_THROWS_WITH(V8Renderer(snapshot),
+                          Contains("ReferenceError") && Contains("render"));
+    }
+  }
+
   SECTION("render map parameters") {
     SECTION("generate expected output for TodoList") {
       V8Renderer renderer(Resources::read("views.js"), Testdata::prototypes(),
@@ -50,6 +110,16 @@ TEST_CASE("V8Renderer", "[v8]") {
       REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
     }
 
+    SECTION("generate expected output for TodoList with lazy mapping") {
+      V8Renderer renderer(Resources::read("views.js"), Testdata::prototypes(),
+                          Testdata::bindings());
+      renderer.setLazyMapping(true);
+      renderer.render("TodoList", Testdata::forTodoList(), stream);
+      renderer.render("TodoList", Testdata::forTodoList(), stream);
+      REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html") +
+                                        Resources::read("todolist.html")));
+    }
+
     SECTION("throws complate::Exception when view is not defined") {
       V8Renderer renderer(Resources::read("views.js"), Testdata::prototypes(),
                           Testdata::bindings());
@@ -110,4 +180,237 @@ TEST_CASE("V8Renderer", "[v8]") {
       REQUIRE_THAT(html, Equals(Resources::read("todolist.html")));
     }
   }
+
+  SECTION("memo") {
+    const string source =
+        "var count = 0;"
+        "function render(view, params, stream) {"
+        "  var footer = memo('footer', function() {"
+        "    return function(s, options, callback) {"
+        "      count++;"
+        "      s.write('<p>' + params.text + '</p>');"
+        "      callback();"
+        "    };"
+        "  });"
+        "  var outer = memo('outer', function() {"
+        "    return function(s, options, callback) {"
+        "      s.write('[');"
+        "      footer(s, options, function() { s.write(']'); callback(); });"
+        "    };"
+        "  });"
+        "  var page = view === 'Outer' ? outer : footer;"
+        "  page(stream, {}, function() { stream.write(' ' + count); });"
+        "}";
+    auto cache = make_shared<MemoCache>();
+    V8Renderer renderer(source);
+    renderer.setMemoCache(cache);
+
+    SECTION("replay the html of a key") {
+      REQUIRE(renderer.renderToString("View", Object{{"text", "a"}}) ==
+              "<p>a</p> 1");
+      REQUIRE(renderer.renderToString("View", Object{{"text", "b"}}) ==
+              "<p>a</p> 1");
+      REQUIRE(*cache->get("footer") == "<p>a</p>");
+    }
+
+    SECTION("render again when invalidated") {
+      renderer.renderToString("View", Object{{"text", "a"}});
+      cache->invalidate("footer");
+      REQUIRE(renderer.renderToString("View", Object{{"text", "b"}}) ==
+              "<p>b</p> 2");
+    }
+
+    SECTION("replay nested memos") {
+      renderer.renderToString("View", Object{{"text", "a"}});
+      REQUIRE(renderer.renderToString("Outer", Object{{"text", "b"}}) ==
+              "[<p>a</p>] 1");
+      REQUIRE(*cache->get("outer") == "[<p>a</p>]");
+    }
+
+    SECTION("share the cache between renderers") {
+      V8Renderer other(source);
+      other.setMemoCache(cache);
+      renderer.renderToString("View", Object{{"text", "a"}});
+      REQUIRE(other.renderToString("View", Object{{"text", "b"}}) ==
+              "<p>a</p> 0");
+    }
+
+    SECTION("prefer a binding named memo") {
+      V8Renderer bound("function render(view, params, stream) {"
+                  "  stream.write(memo());"
+                  "}",
+                  {}, Object{{"memo", Function([] { return "bound"; })}});
+      bound.setMemoCache(cache);
+      REQUIRE(bound.renderToString("View", Object{}) == "bound");
+    }
+  }
+
+  SECTION("htmlEncode") {
+    const string source =
+        "var text = 'plain text';"
+        "var html = { toString: function() { return '<b>'; } };"
+        "function render(view, params, stream) {"
+        "  stream.write([htmlEncode(params.text, params.attribute),"
+        "                htmlEncode(text) === text,"
+        "                htmlEncode(html), htmlEncode(42)].join());"
+        "}";
+    V8Renderer renderer(source);
+    renderer.setHtmlEncode(true);
+
+    SECTION("escape strings and return them when there is nothing to escape") {
+      REQUIRE(renderer.renderToString(
+                  "View", Object{{"text", "'Tom' & Jerry"}}) ==
+              "'Tom' &amp; Jerry,true,&lt;b&gt;,42");
+      REQUIRE(renderer.renderToString(
+                  "View", Object{{"text", "'Tom'"}, {"attribute", true}}) ==
+              "&#x27;Tom&#x27;,true,&lt;b&gt;,42");
+    }
+
+    SECTION("escape non ascii strings") {
+      const Object parameters{{"text", "K\xc3\xa4se & \xe2\x82\xac"}};
+      REQUIRE(renderer.renderToString("View", parameters) ==
+              "K\xc3\xa4se &amp; \xe2\x82\xac,true,&lt;b&gt;,42");
+    }
+
+    SECTION("remove it again") {
+      renderer.setHtmlEncode(false);
+      REQUIRE_THROWS_AS(renderer.renderToString("View", Object{}),
+                        complate::Exception);
+    }
+
+    SECTION("prefer a binding named htmlEncode") {
+      V8Renderer bound("function render(view, params, stream) {"
+                  "  stream.write(htmlEncode('<'));"
+                  "}",
+                  {}, Object{{"htmlEncode", Function([] { return "bound"; })}});
+      bound.setHtmlEncode(true);
+      REQUIRE(bound.renderToString("View", Object{}) == "bound");
+    }
+
+    SECTION("serve a bundle delegating complate-stream's htmlEncode to it") {
+      /* complate-stream's htmlEncode is scoped to the bundle, see the
+       * USER_GUIDE how to let it call the global one */
+      string bundle = Resources::read("views.js");
+      const string declaration = "function htmlEncode(str, attribute) {";
+      bundle.insert(bundle.find(declaration) + declaration.size(),
+                    "\n\treturn globalThis.htmlEncode(str, attribute);");
+      V8Renderer delegating(bundle, Testdata::prototypes(),
+                            Testdata::bindings());
+      delegating.setHtmlEncode(true);
+
+      const Object person{{"person", Object{{"name", "Tom & <Jerry>"}}}};
+      REQUIRE_THAT(delegating.renderToString("Greeting", person),
+                   Contains("<h1>Hello Tom &amp; &lt;Jerry&gt;</h1>"));
+      REQUIRE_THAT(
+          delegating.renderToString("TodoList", Testdata::forTodoList()),
+          Equals(Resources::read("todolist.html")));
+
+      delegating.setHtmlEncode(false);
+      REQUIRE_THROWS_AS(delegating.renderToString("Greeting", person),
+                        complate::Exception);
+    }
+  }
+
+  SECTION("render parsed parameters") {
+    V8Renderer counter(
+        "var count = 0;"
+        "function render(view, params, stream) {"
+        "  stream.write(view + ':' + params.title + ':' + (++count) + ' ');"
+        "}");
+
+    SECTION("render them with several views") {
+      const ParsedParameters parameters = counter.parse(R"({"title": "T"})");
+      counter.render("Page", parameters, stream);
+      counter.render("Teaser", parameters, stream);
+      REQUIRE(counter.renderToString("Card", parameters) == "Card:T:3 ");
+      REQUIRE_THAT(stream.str(), Equals("Page:T:1 Teaser:T:2 "));
+    }
+
+    SECTION("generate expected output for TodoList") {
+      V8Renderer renderer(Resources::read("views.js"), Testdata::prototypes(),
+                          Testdata::bindings());
+      const ParsedParameters parameters =
+          renderer.parse(Testdata::forTodoListViewAsJson());
+      renderer.render("TodoList", parameters, stream);
+      REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
+      REQUIRE_THAT(renderer.renderToString("TodoList", parameters),
+                   Equals(Resources::read("todolist.html")));
+    }
+
+    SECTION("keep changes of a view out of the following renders") {
+      V8Renderer changing(
+          "function render(view, params, stream) {"
+          "  stream.write(params.title + ' ');"
+          "  params.title = view;"
+          "}");
+      const ParsedParameters parameters = changing.parse(R"({"title": "T"})");
+      changing.render("Page", parameters, stream);
+      changing.render("Teaser", parameters, stream);
+      REQUIRE_THAT(stream.str(), Equals("T T "));
+    }
+
+    SECTION("release expired parameters") {
+      for (int i = 0; i < 100; ++i) {
+        const ParsedParameters parameters = counter.parse(R"({"title": 1})");
+        counter.render("View", parameters, stream);
+      }
+      REQUIRE_THAT(stream.str(), Contains("View:1:100 "));
+    }
+
+    SECTION("throws complate::Exception if parameters is not an json object") {
+      REQUIRE_THROWS_WITH(counter.parse("[1"),
+                          Contains("SyntaxError") && Contains("parameters"));
+    }
+
+    SECTION("throws complate::Exception if parsed by another renderer") {
+      V8Renderer other("function render() {}");
+      const ParsedParameters parameters = other.parse("{}");
+      REQUIRE_THROWS_AS(counter.render("View", parameters, stream),
+                        complate::Exception);
+      REQUIRE_THROWS_AS(counter.render("View", ParsedParameters(), stream),
+                        complate::Exception);
+    }
+  }
+
+  SECTION("shared parameters") {
+    V8Renderer renderer(
+        "function render(view, params, stream) {"
+        "  stream.write(params.nav.items.join() + ' ' + params.title);"
+        "  stream.write(' ' + Object.isFrozen(params.nav.items));"
+        "}");
+    renderer.setSharedParameter("nav", Object{{"items", Array{"a", "b"}}});
+    renderer.setSharedParameter("title", "Shared");
+
+    SECTION("pass them with every render") {
+      renderer.render("View", Object{}, stream);
+      renderer.render("View", R"({})", stream);
+      REQUIRE_THAT(stream.str(), Equals("a,b Shared truea,b Shared true"));
+    }
+
+    SECTION("prefer fields of the parameters") {
+      renderer.render("View", Object{{"title", "Own"}}, stream);
+      REQUIRE_THAT(stream.str(), Equals("a,b Own true"));
+    }
+
+    SECTION("pass them with lazy mapping") {
+      renderer.setLazyMapping(true);
+      renderer.render("View", Object{}, stream);
+      REQUIRE_THAT(stream.str(), Equals("a,b Shared true"));
+    }
+
+    SECTION("pass the current ones with parsed parameters") {
+      const ParsedParameters parameters = renderer.parse("{}");
+      renderer.render("View", parameters, stream);
+      renderer.setSharedParameter("title", "Changed");
+      renderer.render("View", parameters, stream);
+      REQUIRE_THAT(stream.str(), Equals("a,b Shared truea,b Changed true"));
+    }
+
+    SECTION("replace and remove them") {
+      renderer.setSharedParameter("nav", Object{{"items", Array{"c"}}});
+      renderer.removeSharedParameter("title");
+      renderer.render("View", Object{}, stream);
+      REQUIRE_THAT(stream.str(), Equals("c undefined true"));
+    }
+  }
 }
@@ -51,6 +51,102 @@ TEST_CASE("V8RendererBuilder", "[V8]") {
     REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
   }
 
+  SECTION("build with snapshot") {
+    auto renderer = V8RendererBuilder()
+        .snapshot(V8Snapshot::create(Resources::read("views.js")))
+        .prototypes(Testdata::prototypes())
+        .bindings(Testdata::bindings())
+        .build();
+
+    renderer.render("TodoList", Testdata::forTodoList(), stream);
+    REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
+  }
+
+  SECTION("build a creator with a created snapshot") {
+    int sourceCalls = 0;
+    auto creator = V8RendererBuilder()
+        .source([&sourceCalls]() {
+          ++sourceCalls;
+          return Resources::read("views.js");
+        })
+        .createSnapshot()
+        .prototypes(Testdata::prototypes)
+        .bindings(Testdata::bindings)
+        .creator();
+
+    creator()->render("TodoList", Testdata::forTodoList(), stream);
+    creator()->render("TodoList", Testdata::forTodoList(), stream);
+    REQUIRE(sourceCalls == 1);
+    REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html") +
+                                      Resources::read("todolist.html")));
+  }
+
+  SECTION("build a creator with code cache") {
+    auto codeCache = make_shared<V8CodeCache>();
+    auto creator = V8RendererBuilder()
+        .source(Resources::read("views.js"))
+        .codeCache(codeCache)
+        .prototypes(Testdata::prototypes)
+        .bindings(Testdata::bindings)
+        .creator();
+
+    creator()->render("TodoList", Testdata::forTodoList(), stream);
+    creator()->render("TodoList", Testdata::forTodoList(), stream);
+    REQUIRE(codeCache->stats().misses == 1);
+    REQUIRE(codeCache->stats().hits == 1);
+  }
+
+  SECTION("build with native htmlEncode") {
+    auto renderer = V8RendererBuilder()
+        .source("function render(view, params, stream) {"
+                "  stream.write(htmlEncode(params.text, true));"
+                "}")
+        .htmlEncode()
+        .build();
+
+    renderer.render("View", Object{{"text", "<'Tom' & \"Jerry\">"}}, stream);
+    REQUIRE_THAT(stream.str(),
+                 Equals("&lt;&#x27;Tom&#x27; &amp; &quot;Jerry&quot;&gt;"));
+  }
+
+  SECTION("build with lazy mapping") {
+    auto renderer = V8RendererBuilder()
+        .source(Resources::read("views.js"))
+        .prototypes(Testdata::prototypes())
+        .bindings(Testdata::bindings())
+        .lazyMapping()
+        .build();
+
+    renderer.render("TodoList", Testdata::forTodoList(), stream);
+    REQUIRE_THAT(stream.str(), Equals(Resources::read("todolist.html")));
+  }
+
+  SECTION("build with shared parameters") {
+    auto renderer = V8RendererBuilder()
+        .source("function render(view, params, stream) {"
+                "  stream.write(params.site.name);"
+                "}")
+        .sharedParameters(Object{{"site", Object{{"name", "complate"}}}})
+        .build();
+
+    renderer.render("View", Object{}, stream);
+    REQUIRE_THAT(stream.str(), Equals("complate"));
+  }
+
+  SECTION("build with memo cache") {
+    auto cache = make_shared<MemoCache>();
+    cache->put("footer", "<footer></footer>");
+    auto renderer = V8RendererBuilder()
+        .source("function render(view, params, stream) {"
+                "  memo('footer', null)(stream, {}, function() {});"
+                "}")
+        .memoCache(cache)
+        .build();
+
+    renderer.render("View", Object{}, stream);
+    REQUIRE_THAT(stream.str(), Equals("<footer></footer>"));
+  }
+
   SECTION("build a unique_ptr") {
     unique_ptr<V8Renderer> unique = V8RendererBuilder()
         .source(Resources::read("views.js"))